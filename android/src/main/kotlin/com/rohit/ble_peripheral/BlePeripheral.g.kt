@@ -212,6 +212,209 @@ data class ManufacturerData (
     )
   }
 }
+
+/** Generated class from Pigeon that represents data sent in messages. */
+data class WriteStreamConfig (
+  val maxBatchCount: Long,
+  val maxBatchBytes: Long,
+  val maxLatencyMs: Long,
+  val capacityBytes: Long
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): WriteStreamConfig {
+      val maxBatchCount = pigeonVar_list[0] as Long
+      val maxBatchBytes = pigeonVar_list[1] as Long
+      val maxLatencyMs = pigeonVar_list[2] as Long
+      val capacityBytes = pigeonVar_list[3] as Long
+      return WriteStreamConfig(maxBatchCount, maxBatchBytes, maxLatencyMs, capacityBytes)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      maxBatchCount,
+      maxBatchBytes,
+      maxLatencyMs,
+      capacityBytes,
+    )
+  }
+}
+
+/** Generated class from Pigeon that represents data sent in messages. */
+data class WriteStreamBatch (
+  val deviceId: String,
+  val characteristicId: String,
+  val data: ByteArray,
+  val lengths: List<Long>,
+  val droppedPackets: Long,
+  val droppedBytes: Long
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): WriteStreamBatch {
+      val deviceId = pigeonVar_list[0] as String
+      val characteristicId = pigeonVar_list[1] as String
+      val data = pigeonVar_list[2] as ByteArray
+      val lengths = pigeonVar_list[3] as List<Long>
+      val droppedPackets = pigeonVar_list[4] as Long
+      val droppedBytes = pigeonVar_list[5] as Long
+      return WriteStreamBatch(deviceId, characteristicId, data, lengths, droppedPackets, droppedBytes)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      deviceId,
+      characteristicId,
+      data,
+      lengths,
+      droppedPackets,
+      droppedBytes,
+    )
+  }
+}
+
+/** Generated class from Pigeon that represents data sent in messages. */
+data class CharacteristicWritePolicy (
+  val acknowledgeImmediately: Boolean,
+  val minLength: Long? = null,
+  val maxLength: Long? = null,
+  val allowedOffsets: List<Long>? = null
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): CharacteristicWritePolicy {
+      val acknowledgeImmediately = pigeonVar_list[0] as Boolean
+      val minLength = pigeonVar_list[1] as Long?
+      val maxLength = pigeonVar_list[2] as Long?
+      val allowedOffsets = pigeonVar_list[3] as List<Long>?
+      return CharacteristicWritePolicy(acknowledgeImmediately, minLength, maxLength, allowedOffsets)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      acknowledgeImmediately,
+      minLength,
+      maxLength,
+      allowedOffsets,
+    )
+  }
+}
+/** Generated class from Pigeon that represents data sent in messages. */
+data class WriteBatchPolicy (
+  val maxCount: Long,
+  val maxBytes: Long,
+  val maxLatencyMs: Long
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): WriteBatchPolicy {
+      val maxCount = pigeonVar_list[0] as Long
+      val maxBytes = pigeonVar_list[1] as Long
+      val maxLatencyMs = pigeonVar_list[2] as Long
+      return WriteBatchPolicy(maxCount, maxBytes, maxLatencyMs)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      maxCount,
+      maxBytes,
+      maxLatencyMs,
+    )
+  }
+}
+/** Generated class from Pigeon that represents data sent in messages. */
+data class WriteRequestBatch (
+  val deviceIds: List<String>,
+  val characteristicIds: List<String>,
+  val offsets: List<Long>,
+  val values: ByteArray,
+  val lengths: List<Long>
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): WriteRequestBatch {
+      val deviceIds = pigeonVar_list[0] as List<String>
+      val characteristicIds = pigeonVar_list[1] as List<String>
+      val offsets = pigeonVar_list[2] as List<Long>
+      val values = pigeonVar_list[3] as ByteArray
+      val lengths = pigeonVar_list[4] as List<Long>
+      return WriteRequestBatch(deviceIds, characteristicIds, offsets, values, lengths)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      deviceIds,
+      characteristicIds,
+      offsets,
+      values,
+      lengths,
+    )
+  }
+}
+/** Generated class from Pigeon that represents data sent in messages. */
+data class AdvertisementSet (
+  val id: String,
+  val services: List<String>,
+  val localName: String? = null,
+  val manufacturerData: ManufacturerData? = null,
+  val connectable: Boolean,
+  val dwellMs: Long,
+  val priority: Long
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): AdvertisementSet {
+      val id = pigeonVar_list[0] as String
+      val services = pigeonVar_list[1] as List<String>
+      val localName = pigeonVar_list[2] as String?
+      val manufacturerData = pigeonVar_list[3] as ManufacturerData?
+      val connectable = pigeonVar_list[4] as Boolean
+      val dwellMs = pigeonVar_list[5] as Long
+      val priority = pigeonVar_list[6] as Long
+      return AdvertisementSet(id, services, localName, manufacturerData, connectable, dwellMs, priority)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      id,
+      services,
+      localName,
+      manufacturerData,
+      connectable,
+      dwellMs,
+      priority,
+    )
+  }
+}
+/** Generated class from Pigeon that represents data sent in messages. */
+data class AdvertisementSetStats (
+  val id: String,
+  val slots: Long,
+  val failures: Long,
+  val airtimeMicros: Long,
+  val airtimeShare: Double
+)
+ {
+  companion object {
+    fun fromList(pigeonVar_list: List<Any?>): AdvertisementSetStats {
+      val id = pigeonVar_list[0] as String
+      val slots = pigeonVar_list[1] as Long
+      val failures = pigeonVar_list[2] as Long
+      val airtimeMicros = pigeonVar_list[3] as Long
+      val airtimeShare = pigeonVar_list[4] as Double
+      return AdvertisementSetStats(id, slots, failures, airtimeMicros, airtimeShare)
+    }
+  }
+  fun toList(): List<Any?> {
+    return listOf(
+      id,
+      slots,
+      failures,
+      airtimeMicros,
+      airtimeShare,
+    )
+  }
+}
 private open class BlePeripheralPigeonCodec : StandardMessageCodec() {
   override fun readValueOfType(type: Byte, buffer: ByteBuffer): Any? {
     return when (type) {
@@ -250,6 +453,41 @@ private open class BlePeripheralPigeonCodec : StandardMessageCodec() {
           ManufacturerData.fromList(it)
         }
       }
+      136.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          WriteStreamConfig.fromList(it)
+        }
+      }
+      137.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          WriteStreamBatch.fromList(it)
+        }
+      }
+      138.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          CharacteristicWritePolicy.fromList(it)
+        }
+      }
+      139.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          WriteBatchPolicy.fromList(it)
+        }
+      }
+      140.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          WriteRequestBatch.fromList(it)
+        }
+      }
+      141.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          AdvertisementSet.fromList(it)
+        }
+      }
+      142.toByte() -> {
+        return (readValue(buffer) as? List<Any?>)?.let {
+          AdvertisementSetStats.fromList(it)
+        }
+      }
       else -> super.readValueOfType(type, buffer)
     }
   }
@@ -283,6 +521,34 @@ private open class BlePeripheralPigeonCodec : StandardMessageCodec() {
         stream.write(135)
         writeValue(stream, value.toList())
       }
+      is WriteStreamConfig -> {
+        stream.write(136)
+        writeValue(stream, value.toList())
+      }
+      is WriteStreamBatch -> {
+        stream.write(137)
+        writeValue(stream, value.toList())
+      }
+      is CharacteristicWritePolicy -> {
+        stream.write(138)
+        writeValue(stream, value.toList())
+      }
+      is WriteBatchPolicy -> {
+        stream.write(139)
+        writeValue(stream, value.toList())
+      }
+      is WriteRequestBatch -> {
+        stream.write(140)
+        writeValue(stream, value.toList())
+      }
+      is AdvertisementSet -> {
+        stream.write(141)
+        writeValue(stream, value.toList())
+      }
+      is AdvertisementSetStats -> {
+        stream.write(142)
+        writeValue(stream, value.toList())
+      }
       else -> super.writeValue(stream, value)
     }
   }
@@ -297,14 +563,25 @@ interface BlePeripheralChannel {
   fun initialize()
   fun isAdvertising(): Boolean?
   fun isSupported(): Boolean
-  fun stopAdvertising()
+  fun stopAdvertising(callback: (Result<Map<String, String>>) -> Unit)
   fun askBlePermission(): Boolean
   fun addService(service: BleService)
   fun removeService(serviceId: String)
   fun clearServices()
   fun getServices(): List<String>
-  fun startAdvertising(services: List<String>, localName: String?, timeout: Long?, manufacturerData: ManufacturerData?, addManufacturerDataInScanResponse: Boolean)
+  fun startAdvertising(services: List<String>, localName: String?, timeout: Long?, manufacturerData: ManufacturerData?, addManufacturerDataInScanResponse: Boolean, callback: (Result<Map<String, String>>) -> Unit)
   fun updateCharacteristic(characteristicId: String, value: ByteArray, deviceId: String?)
+  fun setWriteStreamConfig(characteristicId: String, config: WriteStreamConfig?)
+  fun setCharacteristicWritePolicy(characteristicId: String, policy: CharacteristicWritePolicy?)
+  fun setWriteBatchPolicy(policy: WriteBatchPolicy?)
+  fun addServices(services: List<BleService>, callback: (Result<Map<String, String>>) -> Unit)
+  fun loadGattDatabase(path: String, callback: (Result<Map<String, String>>) -> Unit)
+  fun applyGattDatabase(path: String, callback: (Result<Map<String, String>>) -> Unit)
+  fun getNativeStats(): Map<String, Long>
+  fun startAdvertisementRotation(sets: List<AdvertisementSet>, callback: (Result<Unit>) -> Unit)
+  fun stopAdvertisementRotation(callback: (Result<Unit>) -> Unit)
+  fun getAdvertisementRotationStats(): List<AdvertisementSetStats>
+  fun updateAdvertisingData(localName: String?, manufacturerData: ManufacturerData?)
 
   companion object {
     /** The codec used by BlePeripheralChannel. */
@@ -365,13 +642,15 @@ interface BlePeripheralChannel {
         val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertising$separatedMessageChannelSuffix", codec)
         if (api != null) {
           channel.setMessageHandler { _, reply ->
-            val wrapped: List<Any?> = try {
-              api.stopAdvertising()
-              listOf(null)
-            } catch (exception: Throwable) {
-              wrapError(exception)
+            api.stopAdvertising{ result: Result<Map<String, String>> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                val data = result.getOrNull()
+                reply.reply(wrapResult(data))
+              }
             }
-            reply.reply(wrapped)
           }
         } else {
           channel.setMessageHandler(null)
@@ -469,8 +748,30 @@ interface BlePeripheralChannel {
             val timeoutArg = args[2] as Long?
             val manufacturerDataArg = args[3] as ManufacturerData?
             val addManufacturerDataInScanResponseArg = args[4] as Boolean
+            api.startAdvertising(servicesArg, localNameArg, timeoutArg, manufacturerDataArg, addManufacturerDataInScanResponseArg) { result: Result<Map<String, String>> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                val data = result.getOrNull()
+                reply.reply(wrapResult(data))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateCharacteristic$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val characteristicIdArg = args[0] as String
+            val valueArg = args[1] as ByteArray
+            val deviceIdArg = args[2] as String?
             val wrapped: List<Any?> = try {
-              api.startAdvertising(servicesArg, localNameArg, timeoutArg, manufacturerDataArg, addManufacturerDataInScanResponseArg)
+              api.updateCharacteristic(characteristicIdArg, valueArg, deviceIdArg)
               listOf(null)
             } catch (exception: Throwable) {
               wrapError(exception)
@@ -482,15 +783,196 @@ interface BlePeripheralChannel {
         }
       }
       run {
-        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateCharacteristic$separatedMessageChannelSuffix", codec)
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteStreamConfig$separatedMessageChannelSuffix", codec)
         if (api != null) {
           channel.setMessageHandler { message, reply ->
             val args = message as List<Any?>
             val characteristicIdArg = args[0] as String
-            val valueArg = args[1] as ByteArray
-            val deviceIdArg = args[2] as String?
+            val configArg = args[1] as WriteStreamConfig?
             val wrapped: List<Any?> = try {
-              api.updateCharacteristic(characteristicIdArg, valueArg, deviceIdArg)
+              api.setWriteStreamConfig(characteristicIdArg, configArg)
+              listOf(null)
+            } catch (exception: Throwable) {
+              wrapError(exception)
+            }
+            reply.reply(wrapped)
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setCharacteristicWritePolicy$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val characteristicIdArg = args[0] as String
+            val policyArg = args[1] as CharacteristicWritePolicy?
+            val wrapped: List<Any?> = try {
+              api.setCharacteristicWritePolicy(characteristicIdArg, policyArg)
+              listOf(null)
+            } catch (exception: Throwable) {
+              wrapError(exception)
+            }
+            reply.reply(wrapped)
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteBatchPolicy$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val policyArg = args[0] as WriteBatchPolicy?
+            val wrapped: List<Any?> = try {
+              api.setWriteBatchPolicy(policyArg)
+              listOf(null)
+            } catch (exception: Throwable) {
+              wrapError(exception)
+            }
+            reply.reply(wrapped)
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addServices$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val servicesArg = args[0] as List<BleService>
+            api.addServices(servicesArg) { result: Result<Map<String, String>> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                val data = result.getOrNull()
+                reply.reply(wrapResult(data))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.loadGattDatabase$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val pathArg = args[0] as String
+            api.loadGattDatabase(pathArg) { result: Result<Map<String, String>> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                val data = result.getOrNull()
+                reply.reply(wrapResult(data))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.applyGattDatabase$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val pathArg = args[0] as String
+            api.applyGattDatabase(pathArg) { result: Result<Map<String, String>> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                val data = result.getOrNull()
+                reply.reply(wrapResult(data))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getNativeStats$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { _, reply ->
+            val wrapped: List<Any?> = try {
+              listOf(api.getNativeStats())
+            } catch (exception: Throwable) {
+              wrapError(exception)
+            }
+            reply.reply(wrapped)
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertisementRotation$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val setsArg = args[0] as List<AdvertisementSet>
+            api.startAdvertisementRotation(setsArg) { result: Result<Unit> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                reply.reply(wrapResult(null))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertisementRotation$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { _, reply ->
+            api.stopAdvertisementRotation{ result: Result<Unit> ->
+              val error = result.exceptionOrNull()
+              if (error != null) {
+                reply.reply(wrapError(error))
+              } else {
+                reply.reply(wrapResult(null))
+              }
+            }
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getAdvertisementRotationStats$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { _, reply ->
+            val wrapped: List<Any?> = try {
+              listOf(api.getAdvertisementRotationStats())
+            } catch (exception: Throwable) {
+              wrapError(exception)
+            }
+            reply.reply(wrapped)
+          }
+        } else {
+          channel.setMessageHandler(null)
+        }
+      }
+      run {
+        val channel = BasicMessageChannel<Any?>(binaryMessenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateAdvertisingData$separatedMessageChannelSuffix", codec)
+        if (api != null) {
+          channel.setMessageHandler { message, reply ->
+            val args = message as List<Any?>
+            val localNameArg = args[0] as String?
+            val manufacturerDataArg = args[1] as ManufacturerData?
+            val wrapped: List<Any?> = try {
+              api.updateAdvertisingData(localNameArg, manufacturerDataArg)
               listOf(null)
             } catch (exception: Throwable) {
               wrapError(exception)
@@ -671,4 +1153,38 @@ class BleCallback(private val binaryMessenger: BinaryMessenger, private val mess
       } 
     }
   }
+  fun onWriteStream(batchArg: WriteStreamBatch, callback: (Result<Unit>) -> Unit)
+{
+    val separatedMessageChannelSuffix = if (messageChannelSuffix.isNotEmpty()) ".$messageChannelSuffix" else ""
+    val channelName = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream$separatedMessageChannelSuffix"
+    val channel = BasicMessageChannel<Any?>(binaryMessenger, channelName, codec)
+    channel.send(listOf(batchArg)) {
+      if (it is List<*>) {
+        if (it.size > 1) {
+          callback(Result.failure(FlutterError(it[0] as String, it[1] as String, it[2] as String?)))
+        } else {
+          callback(Result.success(Unit))
+        }
+      } else {
+        callback(Result.failure(createConnectionError(channelName)))
+      } 
+    }
+  }
+  fun onWriteRequestsBatch(batchArg: WriteRequestBatch, callback: (Result<Unit>) -> Unit)
+{
+    val separatedMessageChannelSuffix = if (messageChannelSuffix.isNotEmpty()) ".$messageChannelSuffix" else ""
+    val channelName = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch$separatedMessageChannelSuffix"
+    val channel = BasicMessageChannel<Any?>(binaryMessenger, channelName, codec)
+    channel.send(listOf(batchArg)) {
+      if (it is List<*>) {
+        if (it.size > 1) {
+          callback(Result.failure(FlutterError(it[0] as String, it[1] as String, it[2] as String?)))
+        } else {
+          callback(Result.success(Unit))
+        }
+      } else {
+        callback(Result.failure(createConnectionError(channelName)))
+      } 
+    }
+  }
 }
@@ -116,10 +116,12 @@ class BlePeripheralPlugin : FlutterPlugin, BlePeripheralChannel, ActivityAware {
         timeout: Long?,
         manufacturerData: ManufacturerData?,
         addManufacturerDataInScanResponse: Boolean,
+        callback: (Result<Map<String, String>>) -> Unit,
     ) {
         if (!isBluetoothEnabled()) {
             enableBluetooth()
-            throw Exception("Bluetooth is not enabled")
+            callback(Result.failure(Exception("Bluetooth is not enabled")))
+            return
         }
 
         handler?.post { // set up advertising setting
@@ -163,17 +165,20 @@ class BlePeripheralPlugin : FlutterPlugin, BlePeripheralChannel, ActivityAware {
                 scanResponseBuilder.build(),
                 advertiseCallback
             )
+            // All services share one advertisement, failures arrive in onAdvertisingStatusUpdate
+            callback(Result.success(emptyMap()))
         }
     }
 
-    override fun stopAdvertising() {
+    override fun stopAdvertising(callback: (Result<Map<String, String>>) -> Unit) {
         handler?.post {
             try {
                 bluetoothLeAdvertiser?.stopAdvertising(advertiseCallback)
                 isAdvertising = false
                 bleCallback?.onAdvertisingStatusUpdate(false, null) {}
+                callback(Result.success(emptyMap()))
             } catch (ignored: IllegalStateException) {
-                throw Exception("Bluetooth Adapter is not turned ON")
+                callback(Result.failure(Exception("Bluetooth Adapter is not turned ON")))
             }
         }
     }
@@ -208,6 +213,50 @@ class BlePeripheralPlugin : FlutterPlugin, BlePeripheralChannel, ActivityAware {
         }
     }
 
+    override fun setWriteStreamConfig(characteristicId: String, config: WriteStreamConfig?) {
+        throw UnsupportedOperationException("Write streams are only supported on Windows")
+    }
+
+    override fun setCharacteristicWritePolicy(characteristicId: String, policy: CharacteristicWritePolicy?) {
+        throw UnsupportedOperationException("Write policies are only supported on Windows")
+    }
+
+    override fun setWriteBatchPolicy(policy: WriteBatchPolicy?) {
+        throw UnsupportedOperationException("Write batching is only supported on Windows")
+    }
+
+    override fun addServices(services: List<BleService>, callback: (Result<Map<String, String>>) -> Unit) {
+        callback(Result.failure(UnsupportedOperationException("Adding services in bulk is only supported on Windows")))
+    }
+
+    override fun loadGattDatabase(path: String, callback: (Result<Map<String, String>>) -> Unit) {
+        callback(Result.failure(UnsupportedOperationException("GATT database files are only supported on Windows")))
+    }
+
+    override fun applyGattDatabase(path: String, callback: (Result<Map<String, String>>) -> Unit) {
+        callback(Result.failure(UnsupportedOperationException("GATT database files are only supported on Windows")))
+    }
+
+    override fun getNativeStats(): Map<String, Long> {
+        throw UnsupportedOperationException("Native stats are only supported on Windows")
+    }
+
+    override fun startAdvertisementRotation(sets: List<AdvertisementSet>, callback: (Result<Unit>) -> Unit) {
+        callback(Result.failure(UnsupportedOperationException("Advertisement rotation is only supported on Windows")))
+    }
+
+    override fun stopAdvertisementRotation(callback: (Result<Unit>) -> Unit) {
+        callback(Result.failure(UnsupportedOperationException("Advertisement rotation is only supported on Windows")))
+    }
+
+    override fun getAdvertisementRotationStats(): List<AdvertisementSetStats> {
+        throw UnsupportedOperationException("Advertisement rotation is only supported on Windows")
+    }
+
+    override fun updateAdvertisingData(localName: String?, manufacturerData: ManufacturerData?) {
+        throw UnsupportedOperationException("Updating advertising data is only supported on Windows")
+    }
+
 
     private fun isBluetoothEnabled(): Boolean {
         val bluetoothAdapter: BluetoothAdapter? = bluetoothManager?.adapter
@@ -17,6 +17,7 @@ import Foundation
 
 enum CustomError: Error {
     case notFound(String)
+    case notSupported(String)
 }
 
 /// local list of characteristic
@@ -249,6 +249,254 @@ struct ManufacturerData {
   }
 }
 
+/// Generated class from Pigeon that represents data sent in messages.
+struct WriteStreamConfig {
+  var maxBatchCount: Int64
+  var maxBatchBytes: Int64
+  var maxLatencyMs: Int64
+  var capacityBytes: Int64
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> WriteStreamConfig? {
+    let maxBatchCount = pigeonVar_list[0] as! Int64
+    let maxBatchBytes = pigeonVar_list[1] as! Int64
+    let maxLatencyMs = pigeonVar_list[2] as! Int64
+    let capacityBytes = pigeonVar_list[3] as! Int64
+
+    return WriteStreamConfig(
+      maxBatchCount: maxBatchCount,
+      maxBatchBytes: maxBatchBytes,
+      maxLatencyMs: maxLatencyMs,
+      capacityBytes: capacityBytes
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      maxBatchCount,
+      maxBatchBytes,
+      maxLatencyMs,
+      capacityBytes,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct WriteStreamBatch {
+  var deviceId: String
+  var characteristicId: String
+  var data: FlutterStandardTypedData
+  var lengths: [Int64]
+  var droppedPackets: Int64
+  var droppedBytes: Int64
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> WriteStreamBatch? {
+    let deviceId = pigeonVar_list[0] as! String
+    let characteristicId = pigeonVar_list[1] as! String
+    let data = pigeonVar_list[2] as! FlutterStandardTypedData
+    let lengths = pigeonVar_list[3] as! [Int64]
+    let droppedPackets = pigeonVar_list[4] as! Int64
+    let droppedBytes = pigeonVar_list[5] as! Int64
+
+    return WriteStreamBatch(
+      deviceId: deviceId,
+      characteristicId: characteristicId,
+      data: data,
+      lengths: lengths,
+      droppedPackets: droppedPackets,
+      droppedBytes: droppedBytes
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      deviceId,
+      characteristicId,
+      data,
+      lengths,
+      droppedPackets,
+      droppedBytes,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct CharacteristicWritePolicy {
+  var acknowledgeImmediately: Bool
+  var minLength: Int64? = nil
+  var maxLength: Int64? = nil
+  var allowedOffsets: [Int64]? = nil
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> CharacteristicWritePolicy? {
+    let acknowledgeImmediately = pigeonVar_list[0] as! Bool
+    let minLength: Int64? = nilOrValue(pigeonVar_list[1])
+    let maxLength: Int64? = nilOrValue(pigeonVar_list[2])
+    let allowedOffsets: [Int64]? = nilOrValue(pigeonVar_list[3])
+
+    return CharacteristicWritePolicy(
+      acknowledgeImmediately: acknowledgeImmediately,
+      minLength: minLength,
+      maxLength: maxLength,
+      allowedOffsets: allowedOffsets
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      acknowledgeImmediately,
+      minLength,
+      maxLength,
+      allowedOffsets,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct WriteBatchPolicy {
+  var maxCount: Int64
+  var maxBytes: Int64
+  var maxLatencyMs: Int64
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> WriteBatchPolicy? {
+    let maxCount = pigeonVar_list[0] as! Int64
+    let maxBytes = pigeonVar_list[1] as! Int64
+    let maxLatencyMs = pigeonVar_list[2] as! Int64
+
+    return WriteBatchPolicy(
+      maxCount: maxCount,
+      maxBytes: maxBytes,
+      maxLatencyMs: maxLatencyMs
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      maxCount,
+      maxBytes,
+      maxLatencyMs,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct WriteRequestBatch {
+  var deviceIds: [String]
+  var characteristicIds: [String]
+  var offsets: [Int64]
+  var values: FlutterStandardTypedData
+  var lengths: [Int64]
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> WriteRequestBatch? {
+    let deviceIds = pigeonVar_list[0] as! [String]
+    let characteristicIds = pigeonVar_list[1] as! [String]
+    let offsets = pigeonVar_list[2] as! [Int64]
+    let values = pigeonVar_list[3] as! FlutterStandardTypedData
+    let lengths = pigeonVar_list[4] as! [Int64]
+
+    return WriteRequestBatch(
+      deviceIds: deviceIds,
+      characteristicIds: characteristicIds,
+      offsets: offsets,
+      values: values,
+      lengths: lengths
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      deviceIds,
+      characteristicIds,
+      offsets,
+      values,
+      lengths,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct AdvertisementSet {
+  var id: String
+  var services: [String]
+  var localName: String? = nil
+  var manufacturerData: ManufacturerData? = nil
+  var connectable: Bool
+  var dwellMs: Int64
+  var priority: Int64
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> AdvertisementSet? {
+    let id = pigeonVar_list[0] as! String
+    let services = pigeonVar_list[1] as! [String]
+    let localName: String? = nilOrValue(pigeonVar_list[2])
+    let manufacturerData: ManufacturerData? = nilOrValue(pigeonVar_list[3])
+    let connectable = pigeonVar_list[4] as! Bool
+    let dwellMs = pigeonVar_list[5] as! Int64
+    let priority = pigeonVar_list[6] as! Int64
+
+    return AdvertisementSet(
+      id: id,
+      services: services,
+      localName: localName,
+      manufacturerData: manufacturerData,
+      connectable: connectable,
+      dwellMs: dwellMs,
+      priority: priority
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      id,
+      services,
+      localName,
+      manufacturerData,
+      connectable,
+      dwellMs,
+      priority,
+    ]
+  }
+}
+
+/// Generated class from Pigeon that represents data sent in messages.
+struct AdvertisementSetStats {
+  var id: String
+  var slots: Int64
+  var failures: Int64
+  var airtimeMicros: Int64
+  var airtimeShare: Double
+
+
+  // swift-format-ignore: AlwaysUseLowerCamelCase
+  static func fromList(_ pigeonVar_list: [Any?]) -> AdvertisementSetStats? {
+    let id = pigeonVar_list[0] as! String
+    let slots = pigeonVar_list[1] as! Int64
+    let failures = pigeonVar_list[2] as! Int64
+    let airtimeMicros = pigeonVar_list[3] as! Int64
+    let airtimeShare = pigeonVar_list[4] as! Double
+
+    return AdvertisementSetStats(
+      id: id,
+      slots: slots,
+      failures: failures,
+      airtimeMicros: airtimeMicros,
+      airtimeShare: airtimeShare
+    )
+  }
+  func toList() -> [Any?] {
+    return [
+      id,
+      slots,
+      failures,
+      airtimeMicros,
+      airtimeShare,
+    ]
+  }
+}
+
 private class BlePeripheralPigeonCodecReader: FlutterStandardReader {
   override func readValue(ofType type: UInt8) -> Any? {
     switch type {
@@ -270,6 +518,20 @@ private class BlePeripheralPigeonCodecReader: FlutterStandardReader {
       return WriteRequestResult.fromList(self.readValue() as! [Any?])
     case 135:
       return ManufacturerData.fromList(self.readValue() as! [Any?])
+    case 136:
+      return WriteStreamConfig.fromList(self.readValue() as! [Any?])
+    case 137:
+      return WriteStreamBatch.fromList(self.readValue() as! [Any?])
+    case 138:
+      return CharacteristicWritePolicy.fromList(self.readValue() as! [Any?])
+    case 139:
+      return WriteBatchPolicy.fromList(self.readValue() as! [Any?])
+    case 140:
+      return WriteRequestBatch.fromList(self.readValue() as! [Any?])
+    case 141:
+      return AdvertisementSet.fromList(self.readValue() as! [Any?])
+    case 142:
+      return AdvertisementSetStats.fromList(self.readValue() as! [Any?])
     default:
       return super.readValue(ofType: type)
     }
@@ -299,6 +561,27 @@ private class BlePeripheralPigeonCodecWriter: FlutterStandardWriter {
     } else if let value = value as? ManufacturerData {
       super.writeByte(135)
       super.writeValue(value.toList())
+    } else if let value = value as? WriteStreamConfig {
+      super.writeByte(136)
+      super.writeValue(value.toList())
+    } else if let value = value as? WriteStreamBatch {
+      super.writeByte(137)
+      super.writeValue(value.toList())
+    } else if let value = value as? CharacteristicWritePolicy {
+      super.writeByte(138)
+      super.writeValue(value.toList())
+    } else if let value = value as? WriteBatchPolicy {
+      super.writeByte(139)
+      super.writeValue(value.toList())
+    } else if let value = value as? WriteRequestBatch {
+      super.writeByte(140)
+      super.writeValue(value.toList())
+    } else if let value = value as? AdvertisementSet {
+      super.writeByte(141)
+      super.writeValue(value.toList())
+    } else if let value = value as? AdvertisementSetStats {
+      super.writeByte(142)
+      super.writeValue(value.toList())
     } else {
       super.writeValue(value)
     }
@@ -326,14 +609,25 @@ protocol BlePeripheralChannel {
   func initialize() throws
   func isAdvertising() throws -> Bool?
   func isSupported() throws -> Bool
-  func stopAdvertising() throws
+  func stopAdvertising(completion: @escaping (Result<[String: String], Error>) -> Void)
   func askBlePermission() throws -> Bool
   func addService(service: BleService) throws
   func removeService(serviceId: String) throws
   func clearServices() throws
   func getServices() throws -> [String]
-  func startAdvertising(services: [String], localName: String?, timeout: Int64?, manufacturerData: ManufacturerData?, addManufacturerDataInScanResponse: Bool) throws
+  func startAdvertising(services: [String], localName: String?, timeout: Int64?, manufacturerData: ManufacturerData?, addManufacturerDataInScanResponse: Bool, completion: @escaping (Result<[String: String], Error>) -> Void)
   func updateCharacteristic(characteristicId: String, value: FlutterStandardTypedData, deviceId: String?) throws
+  func setWriteStreamConfig(characteristicId: String, config: WriteStreamConfig?) throws
+  func setCharacteristicWritePolicy(characteristicId: String, policy: CharacteristicWritePolicy?) throws
+  func setWriteBatchPolicy(policy: WriteBatchPolicy?) throws
+  func addServices(services: [BleService], completion: @escaping (Result<[String: String], Error>) -> Void)
+  func loadGattDatabase(path: String, completion: @escaping (Result<[String: String], Error>) -> Void)
+  func applyGattDatabase(path: String, completion: @escaping (Result<[String: String], Error>) -> Void)
+  func getNativeStats() throws -> [String: Int64]
+  func startAdvertisementRotation(sets: [AdvertisementSet], completion: @escaping (Result<Void, Error>) -> Void)
+  func stopAdvertisementRotation(completion: @escaping (Result<Void, Error>) -> Void)
+  func getAdvertisementRotationStats() throws -> [AdvertisementSetStats]
+  func updateAdvertisingData(localName: String?, manufacturerData: ManufacturerData?) throws
 }
 
 /// Generated setup class from Pigeon to handle messages through the `binaryMessenger`.
@@ -384,11 +678,13 @@ class BlePeripheralChannelSetup {
     let stopAdvertisingChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertising\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
     if let api = api {
       stopAdvertisingChannel.setMessageHandler { _, reply in
-        do {
-          try api.stopAdvertising()
-          reply(wrapResult(nil))
-        } catch {
-          reply(wrapError(error))
+        api.stopAdvertising { result in
+          switch result {
+          case .success(let res):
+            reply(wrapResult(res))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
         }
       }
     } else {
@@ -472,11 +768,13 @@ class BlePeripheralChannelSetup {
         let timeoutArg: Int64? = nilOrValue(args[2])
         let manufacturerDataArg: ManufacturerData? = nilOrValue(args[3])
         let addManufacturerDataInScanResponseArg = args[4] as! Bool
-        do {
-          try api.startAdvertising(services: servicesArg, localName: localNameArg, timeout: timeoutArg, manufacturerData: manufacturerDataArg, addManufacturerDataInScanResponse: addManufacturerDataInScanResponseArg)
-          reply(wrapResult(nil))
-        } catch {
-          reply(wrapError(error))
+        api.startAdvertising(services: servicesArg, localName: localNameArg, timeout: timeoutArg, manufacturerData: manufacturerDataArg, addManufacturerDataInScanResponse: addManufacturerDataInScanResponseArg) { result in
+          switch result {
+          case .success(let res):
+            reply(wrapResult(res))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
         }
       }
     } else {
@@ -499,6 +797,178 @@ class BlePeripheralChannelSetup {
     } else {
       updateCharacteristicChannel.setMessageHandler(nil)
     }
+    let setWriteStreamConfigChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteStreamConfig\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      setWriteStreamConfigChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let characteristicIdArg = args[0] as! String
+        let configArg: WriteStreamConfig? = nilOrValue(args[1])
+        do {
+          try api.setWriteStreamConfig(characteristicId: characteristicIdArg, config: configArg)
+          reply(wrapResult(nil))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      setWriteStreamConfigChannel.setMessageHandler(nil)
+    }
+    let setCharacteristicWritePolicyChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setCharacteristicWritePolicy\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      setCharacteristicWritePolicyChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let characteristicIdArg = args[0] as! String
+        let policyArg: CharacteristicWritePolicy? = nilOrValue(args[1])
+        do {
+          try api.setCharacteristicWritePolicy(characteristicId: characteristicIdArg, policy: policyArg)
+          reply(wrapResult(nil))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      setCharacteristicWritePolicyChannel.setMessageHandler(nil)
+    }
+    let setWriteBatchPolicyChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteBatchPolicy\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      setWriteBatchPolicyChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let policyArg: WriteBatchPolicy? = nilOrValue(args[0])
+        do {
+          try api.setWriteBatchPolicy(policy: policyArg)
+          reply(wrapResult(nil))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      setWriteBatchPolicyChannel.setMessageHandler(nil)
+    }
+    let addServicesChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addServices\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      addServicesChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let servicesArg = args[0] as! [BleService]
+        api.addServices(services: servicesArg) { result in
+          switch result {
+          case .success(let res):
+            reply(wrapResult(res))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
+        }
+      }
+    } else {
+      addServicesChannel.setMessageHandler(nil)
+    }
+    let loadGattDatabaseChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.loadGattDatabase\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      loadGattDatabaseChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let pathArg = args[0] as! String
+        api.loadGattDatabase(path: pathArg) { result in
+          switch result {
+          case .success(let res):
+            reply(wrapResult(res))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
+        }
+      }
+    } else {
+      loadGattDatabaseChannel.setMessageHandler(nil)
+    }
+    let applyGattDatabaseChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.applyGattDatabase\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      applyGattDatabaseChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let pathArg = args[0] as! String
+        api.applyGattDatabase(path: pathArg) { result in
+          switch result {
+          case .success(let res):
+            reply(wrapResult(res))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
+        }
+      }
+    } else {
+      applyGattDatabaseChannel.setMessageHandler(nil)
+    }
+    let getNativeStatsChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getNativeStats\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      getNativeStatsChannel.setMessageHandler { _, reply in
+        do {
+          let result = try api.getNativeStats()
+          reply(wrapResult(result))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      getNativeStatsChannel.setMessageHandler(nil)
+    }
+    let startAdvertisementRotationChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertisementRotation\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      startAdvertisementRotationChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let setsArg = args[0] as! [AdvertisementSet]
+        api.startAdvertisementRotation(sets: setsArg) { result in
+          switch result {
+          case .success:
+            reply(wrapResult(nil))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
+        }
+      }
+    } else {
+      startAdvertisementRotationChannel.setMessageHandler(nil)
+    }
+    let stopAdvertisementRotationChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertisementRotation\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      stopAdvertisementRotationChannel.setMessageHandler { _, reply in
+        api.stopAdvertisementRotation { result in
+          switch result {
+          case .success:
+            reply(wrapResult(nil))
+          case .failure(let error):
+            reply(wrapError(error))
+          }
+        }
+      }
+    } else {
+      stopAdvertisementRotationChannel.setMessageHandler(nil)
+    }
+    let getAdvertisementRotationStatsChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getAdvertisementRotationStats\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      getAdvertisementRotationStatsChannel.setMessageHandler { _, reply in
+        do {
+          let result = try api.getAdvertisementRotationStats()
+          reply(wrapResult(result))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      getAdvertisementRotationStatsChannel.setMessageHandler(nil)
+    }
+    let updateAdvertisingDataChannel = FlutterBasicMessageChannel(name: "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateAdvertisingData\(channelSuffix)", binaryMessenger: binaryMessenger, codec: codec)
+    if let api = api {
+      updateAdvertisingDataChannel.setMessageHandler { message, reply in
+        let args = message as! [Any?]
+        let localNameArg: String? = nilOrValue(args[0])
+        let manufacturerDataArg: ManufacturerData? = nilOrValue(args[1])
+        do {
+          try api.updateAdvertisingData(localName: localNameArg, manufacturerData: manufacturerDataArg)
+          reply(wrapResult(nil))
+        } catch {
+          reply(wrapError(error))
+        }
+      }
+    } else {
+      updateAdvertisingDataChannel.setMessageHandler(nil)
+    }
   }
 }
 /// Native -> Flutter
@@ -514,6 +984,8 @@ protocol BleCallbackProtocol {
   func onMtuChange(deviceId deviceIdArg: String, mtu mtuArg: Int64, completion: @escaping (Result<Void, PigeonError>) -> Void)
   func onConnectionStateChange(deviceId deviceIdArg: String, connected connectedArg: Bool, completion: @escaping (Result<Void, PigeonError>) -> Void)
   func onBondStateChange(deviceId deviceIdArg: String, bondState bondStateArg: BondState, completion: @escaping (Result<Void, PigeonError>) -> Void)
+  func onWriteStream(batch batchArg: WriteStreamBatch, completion: @escaping (Result<Void, PigeonError>) -> Void)
+  func onWriteRequestsBatch(batch batchArg: WriteRequestBatch, completion: @escaping (Result<Void, PigeonError>) -> Void)
 }
 class BleCallback: BleCallbackProtocol {
   private let binaryMessenger: FlutterBinaryMessenger
@@ -689,4 +1161,40 @@ class BleCallback: BleCallbackProtocol {
       }
     }
   }
+  func onWriteStream(batch batchArg: WriteStreamBatch, completion: @escaping (Result<Void, PigeonError>) -> Void) {
+    let channelName: String = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream\(messageChannelSuffix)"
+    let channel = FlutterBasicMessageChannel(name: channelName, binaryMessenger: binaryMessenger, codec: codec)
+    channel.sendMessage([batchArg] as [Any?]) { response in
+      guard let listResponse = response as? [Any?] else {
+        completion(.failure(createConnectionError(withChannelName: channelName)))
+        return
+      }
+      if listResponse.count > 1 {
+        let code: String = listResponse[0] as! String
+        let message: String? = nilOrValue(listResponse[1])
+        let details: String? = nilOrValue(listResponse[2])
+        completion(.failure(PigeonError(code: code, message: message, details: details)))
+      } else {
+        completion(.success(Void()))
+      }
+    }
+  }
+  func onWriteRequestsBatch(batch batchArg: WriteRequestBatch, completion: @escaping (Result<Void, PigeonError>) -> Void) {
+    let channelName: String = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch\(messageChannelSuffix)"
+    let channel = FlutterBasicMessageChannel(name: channelName, binaryMessenger: binaryMessenger, codec: codec)
+    channel.sendMessage([batchArg] as [Any?]) { response in
+      guard let listResponse = response as? [Any?] else {
+        completion(.failure(createConnectionError(withChannelName: channelName)))
+        return
+      }
+      if listResponse.count > 1 {
+        let code: String = listResponse[0] as! String
+        let message: String? = nilOrValue(listResponse[1])
+        let details: String? = nilOrValue(listResponse[2])
+        completion(.failure(PigeonError(code: code, message: message, details: details)))
+      } else {
+        completion(.success(Void()))
+      }
+    }
+  }
 }
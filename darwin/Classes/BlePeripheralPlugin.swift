@@ -78,7 +78,7 @@ private class BlePeripheralDarwin: NSObject, BlePeripheralChannel, CBPeripheralM
         }
     }
 
-    func startAdvertising(services: [String], localName: String?, timeout _: Int64?, manufacturerData _: ManufacturerData?, addManufacturerDataInScanResponse _: Bool) throws {
+    func startAdvertising(services: [String], localName: String?, timeout _: Int64?, manufacturerData _: ManufacturerData?, addManufacturerDataInScanResponse _: Bool, completion: @escaping (Result<[String: String], Error>) -> Void) {
         let cbServices = services.map { uuidString in
             CBUUID(string: uuidString)
         }
@@ -96,11 +96,14 @@ private class BlePeripheralDarwin: NSObject, BlePeripheralChannel, CBPeripheralM
 //        }
 //        print("AdvertisementData: \(advertisementData)")
         peripheralManager.startAdvertising(advertisementData)
+        // All services share one advertisement, failures arrive in onAdvertisingStatusUpdate
+        completion(.success([:]))
     }
 
-    func stopAdvertising() throws {
+    func stopAdvertising(completion: @escaping (Result<[String: String], Error>) -> Void) {
         peripheralManager.stopAdvertising()
         bleCallback.onAdvertisingStatusUpdate(advertising: false, error: nil, completion: { _ in })
+        completion(.success([:]))
     }
 
     func updateCentralList(central: CBCentral) {
@@ -126,6 +129,50 @@ private class BlePeripheralDarwin: NSObject, BlePeripheralChannel, CBPeripheralM
         }
     }
 
+    func setWriteStreamConfig(characteristicId _: String, config _: WriteStreamConfig?) throws {
+        throw CustomError.notSupported("Write streams are only supported on Windows")
+    }
+
+    func setCharacteristicWritePolicy(characteristicId _: String, policy _: CharacteristicWritePolicy?) throws {
+        throw CustomError.notSupported("Write policies are only supported on Windows")
+    }
+
+    func setWriteBatchPolicy(policy _: WriteBatchPolicy?) throws {
+        throw CustomError.notSupported("Write batching is only supported on Windows")
+    }
+
+    func addServices(services _: [BleService], completion: @escaping (Result<[String: String], Error>) -> Void) {
+        completion(.failure(CustomError.notSupported("Adding services in bulk is only supported on Windows")))
+    }
+
+    func loadGattDatabase(path _: String, completion: @escaping (Result<[String: String], Error>) -> Void) {
+        completion(.failure(CustomError.notSupported("GATT database files are only supported on Windows")))
+    }
+
+    func applyGattDatabase(path _: String, completion: @escaping (Result<[String: String], Error>) -> Void) {
+        completion(.failure(CustomError.notSupported("GATT database files are only supported on Windows")))
+    }
+
+    func getNativeStats() throws -> [String: Int64] {
+        throw CustomError.notSupported("Native stats are only supported on Windows")
+    }
+
+    func startAdvertisementRotation(sets _: [AdvertisementSet], completion: @escaping (Result<Void, Error>) -> Void) {
+        completion(.failure(CustomError.notSupported("Advertisement rotation is only supported on Windows")))
+    }
+
+    func stopAdvertisementRotation(completion: @escaping (Result<Void, Error>) -> Void) {
+        completion(.failure(CustomError.notSupported("Advertisement rotation is only supported on Windows")))
+    }
+
+    func getAdvertisementRotationStats() throws -> [AdvertisementSetStats] {
+        throw CustomError.notSupported("Advertisement rotation is only supported on Windows")
+    }
+
+    func updateAdvertisingData(localName _: String?, manufacturerData _: ManufacturerData?) throws {
+        throw CustomError.notSupported("Updating advertising data is only supported on Windows")
+    }
+
     /// Swift callbacks
     internal nonisolated func peripheralManagerDidStartAdvertising(_: CBPeripheralManager, error: Error?) {
         bleCallback.onAdvertisingStatusUpdate(advertising: error == nil, error: error?.localizedDescription, completion: { _ in })
@@ -2,4 +2,5 @@ library ble_peripheral;
 
 export 'package:ble_peripheral/src/ble_peripheral.dart';
 export 'package:ble_peripheral/src/models/ble_enums.dart';
+export 'package:ble_peripheral/src/models/write_ring_record.dart';
 export 'package:ble_peripheral/src/generated/ble_peripheral.g.dart';
@@ -5,6 +5,7 @@ import 'package:ble_peripheral/src/generated/ble_peripheral.g.dart';
 import 'package:ble_peripheral/src/pigeon/ble_peripheral_pigeon.dart';
 import 'package:flutter/foundation.dart';
 export 'package:ble_peripheral/src/models/ble_enums.dart';
+export 'package:ble_peripheral/src/models/write_ring_record.dart';
 export 'package:ble_peripheral/src/generated/ble_peripheral.g.dart';
 
 /// [BlePeripheral] is the main class to interact with the BLE peripheral plugin.
@@ -45,6 +46,76 @@ class BlePeripheral {
     return _platform.addService(service, timeout: timeout);
   }
 
+  /// Add all [services] at once, resolves with the error of every failed service by its uuid,
+  /// an empty map means all services were added
+  /// On Windows the services are built concurrently and [timeout] is not used,
+  /// other platforms add them one after another, with [timeout] for each service
+  static Future<Map<String, String>> addServices(
+    List<BleService> services, {
+    Duration? timeout,
+  }) {
+    return _platform.addServices(services, timeout: timeout);
+  }
+
+  /// Build all services of the JSON GATT database file at [path] natively,
+  /// resolves like [addServices], see README for the file format
+  /// Throws a PlatformException listing every schema error if the file is invalid,
+  /// its details hold the errors as a list, no service is added in that case
+  /// Only available on Windows
+  static Future<Map<String, String>> loadGattDatabase(String path) =>
+      _platform.loadGattDatabase(path);
+
+  /// Make the added services match the GATT database file at [path]
+  /// Services whose structure changed are rebuilt, services only differing in characteristic values
+  /// keep their provider and subscribers, services missing from the file are removed
+  /// Resolves with the error of every service that failed to rebuild, by its uuid
+  /// Only available on Windows
+  static Future<Map<String, String>> applyGattDatabase(String path) =>
+      _platform.applyGattDatabase(path);
+
+  /// Counters of live native objects, like `liveServices`, `liveCharacteristics` and `gattObjectBytes`
+  /// They should return to the same values after services are removed and added again
+  /// `callbacksSent`/`callbackSendNanos` and `callbackReplies`/`callbackReplyNanos` give the
+  /// native cost of encoding, sending and decoding callbacks to Dart, read and write requests
+  /// use a fixed binary layout and are counted as `binaryCallbacksSent`/`binaryCallbackSendNanos`
+  /// and `binaryCallbackReplies`/`binaryCallbackReplyNanos`
+  /// `writeRingDropped` counts requests lost while the write ring was full
+  /// `logDropped` counts native log lines lost while the log ring was full
+  /// Only available on Windows
+  static Future<Map<String, int>> getNativeStats() => _platform.getNativeStats();
+
+  /// Time-slice advertisement [sets] natively, one set on air at a time for its `dwellMs`
+  /// Sets of higher `priority` get proportionally more slots, connectable sets advertise the added services
+  /// Replaces [startAdvertising] until [stopAdvertisementRotation] is called,
+  /// resolves once plain advertising stopped and the rotation started off the platform thread
+  /// Only available on Windows
+  static Future<void> startAdvertisementRotation(List<AdvertisementSet> sets) =>
+      _platform.startAdvertisementRotation(sets);
+
+  /// Resolves once the rotation is off air
+  /// Only available on Windows
+  static Future<void> stopAdvertisementRotation() =>
+      _platform.stopAdvertisementRotation();
+
+  /// Slots, failed starts and measured airtime of each set of the running rotation,
+  /// `airtimeShare` is the airtime over the time the rotation has been running
+  /// Only available on Windows
+  static Future<List<AdvertisementSetStats>> getAdvertisementRotationStats() =>
+      _platform.getAdvertisementRotationStats();
+
+  /// Replace the [localName] and [manufacturerData] of a running advertisement without restarting it
+  /// The new payload goes on air before the previous one is stopped, so there is no gap in discoverability
+  /// Updates are applied at most every 100ms, only the newest of the updates arriving in between is applied
+  /// Only available on Windows
+  static Future<void> updateAdvertisingData({
+    String? localName,
+    ManufacturerData? manufacturerData,
+  }) =>
+      _platform.updateAdvertisingData(
+        localName: localName,
+        manufacturerData: manufacturerData,
+      );
+
   /// Remove a service from the peripheral
   static Future<void> removeService(String serviceId) =>
       _platform.removeService(serviceId);
@@ -65,9 +136,46 @@ class BlePeripheral {
         characteristicId: characteristicId, value: value, deviceId: deviceId);
   }
 
+  /// Same as [updateCharacteristic], but the value is handed to the plugin through dart:ffi,
+  /// skipping the platform channel, for high rate notifications
+  /// Throws a PlatformException right away if the value could not be sent
+  /// Only available on Windows
+  static void updateCharacteristicSync({
+    required String characteristicId,
+    required Uint8List value,
+    String? deviceId,
+  }) {
+    _platform.updateCharacteristicSync(
+        characteristicId: characteristicId, value: value, deviceId: deviceId);
+  }
+
+  /// Receive writeWithoutResponse requests of all characteristics through a native ring
+  /// of [capacity] bytes that Dart reads in place, instead of [setWriteRequestCallback]
+  /// or [setWriteRequestsBatchCallback], characteristics with a write stream config keep their stream
+  /// [onRecords] gets every record readable at once, their values are only valid during the call
+  /// Records arriving while the ring is full are dropped and counted as `writeRingDropped` in [getNativeStats]
+  /// Only available on Windows
+  static void startWriteRing({
+    required WriteRingCallback onRecords,
+    int capacity = 1 << 20,
+  }) =>
+      _platform.startWriteRing(onRecords: onRecords, capacity: capacity);
+
+  /// Deliver writeWithoutResponse requests through the callbacks again
+  /// Only available on Windows
+  static void stopWriteRing() => _platform.stopWriteRing();
+
   /// Start advertising with the given services and local name
   /// make sure to add services before calling this method
-  static Future<void> startAdvertising({
+  /// On Windows [localName] and [manufacturerData] are published next to the service advertisements,
+  /// leaving out the service uuids if they do not fit a legacy advertisement, and with extended advertising
+  /// if they still do not fit and the adapter supports it,
+  /// and advertising stops after [timeout] milliseconds
+  /// Resolves once advertising started, with the error of every service that failed to start by its uuid
+  /// On Windows the services are started off the platform thread as one transaction,
+  /// if any service fails the others are stopped again and the future fails with
+  /// a PlatformException holding the error of every failed service by its uuid as details
+  static Future<Map<String, String>> startAdvertising({
     required List<String> services,
     String? localName,
     int? timeout,
@@ -83,8 +191,46 @@ class BlePeripheral {
     );
   }
 
-  /// Stop advertising
-  static Future<void> stopAdvertising() => _platform.stopAdvertising();
+  /// Stop advertising, resolves like [startAdvertising] with the services that failed to stop
+  static Future<Map<String, String>> stopAdvertising() =>
+      _platform.stopAdvertising();
+
+  /// Buffer writeWithoutResponse packets of [characteristicId] natively and
+  /// deliver them in batches to [setWriteStreamCallback], pass null [config] to disable
+  /// Streamed packets no longer reach [setWriteRequestCallback]
+  /// Only available on Windows
+  static Future<void> setWriteStreamConfig({
+    required String characteristicId,
+    WriteStreamConfig? config,
+  }) {
+    return _platform.setWriteStreamConfig(
+        characteristicId: characteristicId, config: config);
+  }
+
+  /// Validate writes to [characteristicId] natively, pass null [policy] to remove it
+  /// Writes violating the policy are rejected without calling [setWriteRequestCallback]
+  /// With [CharacteristicWritePolicy.acknowledgeImmediately], valid writes are responded
+  /// before [setWriteRequestCallback] is called, and its result is ignored
+  /// [CharacteristicWritePolicy.allowedOffsets] are checked for every fragment of a prepared (long) write,
+  /// ordinary writes and writeWithoutResponse start at offset 0
+  /// [CharacteristicWritePolicy.minLength] and [CharacteristicWritePolicy.maxLength] apply to the offset
+  /// plus the length of a write, the minimum only to writes that end the value
+  /// Only available on Windows
+  static Future<void> setCharacteristicWritePolicy({
+    required String characteristicId,
+    CharacteristicWritePolicy? policy,
+  }) {
+    return _platform.setCharacteristicWritePolicy(
+        characteristicId: characteristicId, policy: policy);
+  }
+
+  /// Deliver writeWithoutResponse requests of all characteristics in batches,
+  /// flushed by [WriteBatchPolicy.maxCount], [WriteBatchPolicy.maxBytes] or [WriteBatchPolicy.maxLatencyMs]
+  /// Batches go to [setWriteRequestsBatchCallback], or to [setWriteRequestCallback] one by one if not set
+  /// Pass null [policy] to deliver every request on its own again
+  /// Only available on Windows
+  static Future<void> setWriteBatchPolicy(WriteBatchPolicy? policy) =>
+      _platform.setWriteBatchPolicy(policy);
 
   /// Get the callback when advertising is started or stopped
   static void setAdvertisingStatusUpdateCallback(
@@ -100,11 +246,14 @@ class BlePeripheral {
       _platform.setBondStateChangeCallback(callback);
 
   /// Only available on iOS/Mac/Windows
+  /// On Windows, name is null until the device name is resolved once,
+  /// the callback is then called again with the same arguments and the name
   static void setCharacteristicSubscriptionChangeCallback(
           CharacteristicSubscriptionChangeCallback callback) =>
       _platform.setCharacteristicSubscriptionChangeCallback(callback);
 
-  /// Only available on Android
+  /// Only available on Android/Windows
+  /// On Windows, a device is reported connected once it sends a request or subscribes
   static void setConnectionStateChangeCallback(
           ConnectionStateChangeCallback callback) =>
       _platform.setConnectionStateChangeCallback(callback);
@@ -114,7 +263,9 @@ class BlePeripheral {
       _platform.setMtuChangeCallback(callback);
 
   /// Get the callback when a read request is made
-  static void setReadRequestCallback(ReadRequestCallback callback) =>
+  /// On Windows, reads of characteristics added with a value are answered natively
+  /// while no callback is set, passing null restores that
+  static void setReadRequestCallback(ReadRequestCallback? callback) =>
       _platform.setReadRequestCallback(callback);
 
   /// Get the callback when a service is added
@@ -124,4 +275,17 @@ class BlePeripheral {
   /// Get the callback when a write request is made
   static void setWriteRequestCallback(WriteRequestCallback callback) =>
       _platform.setWriteRequestCallback(callback);
+
+  /// Get batches of streamed writeWithoutResponse packets,
+  /// split [WriteStreamBatch.data] using [WriteStreamBatch.lengths]
+  /// Only available on Windows
+  static void setWriteStreamCallback(WriteStreamCallback callback) =>
+      _platform.setWriteStreamCallback(callback);
+
+  /// Get batches of writeWithoutResponse requests configured using [setWriteBatchPolicy],
+  /// split [WriteRequestBatch.values] using [WriteRequestBatch.lengths]
+  /// Only available on Windows
+  static void setWriteRequestsBatchCallback(
+          WriteRequestsBatchCallback callback) =>
+      _platform.setWriteRequestsBatchCallback(callback);
 }
@@ -13,6 +13,63 @@ abstract class BlePeripheralInterface {
 
   Future<void> addService(BleService service, {Duration? timeout});
 
+  Future<Map<String, String>> addServices(
+    List<BleService> services, {
+    Duration? timeout,
+  }) {
+    throw UnimplementedError();
+  }
+
+  Future<Map<String, String>> loadGattDatabase(String path) {
+    throw UnimplementedError();
+  }
+
+  Future<Map<String, String>> applyGattDatabase(String path) {
+    throw UnimplementedError();
+  }
+
+  Future<Map<String, int>> getNativeStats() {
+    throw UnimplementedError();
+  }
+
+  Future<void> startAdvertisementRotation(List<AdvertisementSet> sets) {
+    throw UnimplementedError();
+  }
+
+  Future<void> stopAdvertisementRotation() {
+    throw UnimplementedError();
+  }
+
+  Future<List<AdvertisementSetStats>> getAdvertisementRotationStats() {
+    throw UnimplementedError();
+  }
+
+  Future<void> updateAdvertisingData({
+    String? localName,
+    ManufacturerData? manufacturerData,
+  }) {
+    throw UnimplementedError();
+  }
+
+  void updateCharacteristicSync({
+    required String characteristicId,
+    required Uint8List value,
+    String? deviceId,
+  }) {
+    throw UnimplementedError();
+  }
+
+  void startWriteRing({
+    required WriteRingCallback onRecords,
+    int capacity = 1 << 20,
+  }) {
+    throw UnimplementedError();
+  }
+
+  void stopWriteRing() {
+    throw UnimplementedError();
+  }
+
   Future<void> removeService(String serviceId) {
     throw UnimplementedError();
   }
@@ -31,7 +88,7 @@ abstract class BlePeripheralInterface {
     String? deviceId,
   });
 
-  Future<void> startAdvertising({
+  Future<Map<String, String>> startAdvertising({
     required List<String> services,
     String? localName,
     int? timeout,
@@ -39,7 +96,25 @@ abstract class BlePeripheralInterface {
     bool addManufacturerDataInScanResponse = false,
   });
 
-  Future<void> stopAdvertising();
+  Future<Map<String, String>> stopAdvertising();
+
+  Future<void> setWriteStreamConfig({
+    required String characteristicId,
+    WriteStreamConfig? config,
+  }) {
+    throw UnimplementedError();
+  }
+
+  Future<void> setCharacteristicWritePolicy({
+    required String characteristicId,
+    CharacteristicWritePolicy? policy,
+  }) {
+    throw UnimplementedError();
+  }
+
+  Future<void> setWriteBatchPolicy(WriteBatchPolicy? policy) {
+    throw UnimplementedError();
+  }
 
   /// Callback handlers
   void setAdvertisingStatusUpdateCallback(
@@ -69,7 +144,7 @@ abstract class BlePeripheralInterface {
     throw UnimplementedError();
   }
 
-  void setReadRequestCallback(ReadRequestCallback callback) {
+  void setReadRequestCallback(ReadRequestCallback? callback) {
     throw UnimplementedError();
   }
 
@@ -80,6 +155,14 @@ abstract class BlePeripheralInterface {
   void setWriteRequestCallback(WriteRequestCallback callback) {
     throw UnimplementedError();
   }
+
+  void setWriteStreamCallback(WriteStreamCallback callback) {
+    throw UnimplementedError();
+  }
+
+  void setWriteRequestsBatchCallback(WriteRequestsBatchCallback callback) {
+    throw UnimplementedError();
+  }
 }
 
 typedef AvailableDevicesListener = void Function(
@@ -107,3 +190,9 @@ typedef WriteRequestCallback = WriteRequestResult? Function(
     String deviceId, String characteristicId, int offset, Uint8List? value);
 
 typedef MtuChangeCallback = void Function(String deviceId, int mtu);
+
+typedef WriteStreamCallback = void Function(WriteStreamBatch batch);
+
+typedef WriteRequestsBatchCallback = void Function(WriteRequestBatch batch);
+
+typedef WriteRingCallback = void Function(List<WriteRingRecord> records);
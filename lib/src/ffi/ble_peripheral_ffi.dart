@@ -0,0 +1,229 @@
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:ble_peripheral/src/ble_peripheral_interface.dart';
+import 'package:ble_peripheral/src/models/write_ring_record.dart';
+import 'package:flutter/services.dart';
+
+typedef _AllocBufferNative = Pointer<Uint8> Function(Size size);
+typedef _AllocBuffer = Pointer<Uint8> Function(int size);
+typedef _FreeBufferNative = Void Function(Pointer<Uint8> buffer);
+typedef _FreeBuffer = void Function(Pointer<Uint8> buffer);
+typedef _NotifyValueNative = Int32 Function(
+  Pointer<Uint8> characteristicId,
+  Size characteristicIdLength,
+  Pointer<Uint8> deviceId,
+  Size deviceIdLength,
+  Pointer<Uint8> value,
+  Size valueLength,
+);
+typedef _NotifyValue = int Function(
+  Pointer<Uint8> characteristicId,
+  int characteristicIdLength,
+  Pointer<Uint8> deviceId,
+  int deviceIdLength,
+  Pointer<Uint8> value,
+  int valueLength,
+);
+typedef _WriteRingStartNative = Int32 Function(
+    Size capacity, Pointer<Void> postCObject, Int64 port);
+typedef _WriteRingStart = int Function(
+    int capacity, Pointer<Void> postCObject, int port);
+typedef _VoidNative = Void Function();
+typedef _Void = void Function();
+typedef _WriteRingReadableNative = Size Function();
+typedef _WriteRingReadable = int Function();
+typedef _WriteRingReadPointerNative = Pointer<Uint8> Function();
+typedef _WriteRingReadPointer = Pointer<Uint8> Function();
+typedef _WriteRingReleaseNative = Void Function(Size length);
+typedef _WriteRingRelease = void Function(int length);
+
+/// Pushes characteristic values into the Windows plugin through dart:ffi,
+/// see windows/include/ble_peripheral/ble_peripheral_ffi.h
+/// Values skip the channel codec and the hop to the platform thread,
+/// everything else keeps going through the platform channel.
+/// writeWithoutResponse requests can come back the same way through the write ring
+class BlePeripheralFfi {
+  BlePeripheralFfi._(DynamicLibrary library)
+      : _allocBuffer = library
+            .lookupFunction<_AllocBufferNative, _AllocBuffer>(
+                'BlePeripheralAllocBuffer'),
+        _freeBuffer = library.lookupFunction<_FreeBufferNative, _FreeBuffer>(
+            'BlePeripheralFreeBuffer'),
+        _notifyValue = library.lookupFunction<_NotifyValueNative, _NotifyValue>(
+            'BlePeripheralNotifyValue'),
+        _writeRingStart =
+            library.lookupFunction<_WriteRingStartNative, _WriteRingStart>(
+                'BlePeripheralWriteRingStart'),
+        _writeRingStop = library
+            .lookupFunction<_VoidNative, _Void>('BlePeripheralWriteRingStop'),
+        _writeRingRearm = library
+            .lookupFunction<_VoidNative, _Void>('BlePeripheralWriteRingRearm'),
+        _writeRingReadable = library.lookupFunction<_WriteRingReadableNative,
+            _WriteRingReadable>('BlePeripheralWriteRingReadable'),
+        _writeRingReadPointer = library.lookupFunction<
+            _WriteRingReadPointerNative,
+            _WriteRingReadPointer>('BlePeripheralWriteRingReadPointer'),
+        _writeRingRelease =
+            library.lookupFunction<_WriteRingReleaseNative, _WriteRingRelease>(
+                'BlePeripheralWriteRingRelease');
+
+  static final BlePeripheralFfi instance =
+      BlePeripheralFfi._(DynamicLibrary.open('ble_peripheral_plugin.dll'));
+
+  final _AllocBuffer _allocBuffer;
+  final _FreeBuffer _freeBuffer;
+  final _NotifyValue _notifyValue;
+  final _WriteRingStart _writeRingStart;
+  final _Void _writeRingStop;
+  final _Void _writeRingRearm;
+  final _WriteRingReadable _writeRingReadable;
+  final _WriteRingReadPointer _writeRingReadPointer;
+  final _WriteRingRelease _writeRingRelease;
+
+  // Wakes the consumer whenever the write ring turns readable
+  ReceivePort? _writeRingPort;
+
+  // Native buffer reused by every call, grown when a message does not fit
+  Pointer<Uint8> _buffer = nullptr;
+  int _capacity = 0;
+  final Map<String, Uint8List> _encodedIds = {};
+
+  void notifyValue({
+    required String characteristicId,
+    required Uint8List value,
+    String? deviceId,
+  }) {
+    final characteristic = _encode(characteristicId);
+    final device = deviceId == null ? null : _encode(deviceId);
+    final deviceOffset = characteristic.length;
+    final valueOffset = deviceOffset + (device?.length ?? 0);
+    _reserve(valueOffset + value.length);
+
+    final bytes = _buffer.asTypedList(_capacity);
+    bytes.setAll(0, characteristic);
+    if (device != null) bytes.setAll(deviceOffset, device);
+    bytes.setAll(valueOffset, value);
+
+    final result = _notifyValue(
+      _buffer,
+      characteristic.length,
+      device == null ? nullptr : _at(deviceOffset),
+      device?.length ?? 0,
+      _at(valueOffset),
+      value.length,
+    );
+    switch (result) {
+      case 0:
+        return;
+      case -1:
+        throw PlatformException(
+            code: 'not-registered', message: 'Plugin is not registered yet');
+      case -2:
+        throw PlatformException(
+            code: 'error', message: 'Failed to get this characteristic');
+      case -3:
+        throw PlatformException(
+            code: 'error',
+            message: 'Device is not subscribed to this characteristic');
+      case -4:
+        throw PlatformException(
+            code: 'error', message: 'Value exceeds the MTU of this device');
+      default:
+        throw PlatformException(
+            code: 'error', message: 'Failed to notify value, code $result');
+    }
+  }
+
+  void startWriteRing({
+    required int capacity,
+    required WriteRingCallback onRecords,
+  }) {
+    stopWriteRing();
+    final port = ReceivePort();
+    final result = _writeRingStart(
+        capacity, NativeApi.postCObject.cast(), port.sendPort.nativePort);
+    if (result != 0) {
+      port.close();
+      throw PlatformException(
+          code: result == -1 ? 'not-registered' : 'error',
+          message: 'Failed to start the write ring, code $result');
+    }
+    _writeRingPort = port;
+    port.listen((_) => _drainWriteRing(onRecords));
+  }
+
+  void stopWriteRing() {
+    if (_writeRingPort == null) return;
+    _writeRingPort!.close();
+    _writeRingPort = null;
+    _writeRingStop();
+  }
+
+  void _drainWriteRing(WriteRingCallback onRecords) {
+    // Rearm first, a record appended while draining sends another wakeup
+    _writeRingRearm();
+    for (var readable = _writeRingReadable();
+        readable > 0;
+        readable = _writeRingReadable()) {
+      final bytes = _writeRingReadPointer().asTypedList(readable);
+      final header = ByteData.sublistView(bytes);
+      final records = <WriteRingRecord>[];
+      for (var position = 0; position < readable;) {
+        final recordLength = header.getUint32(position, Endian.little);
+        final deviceIdLength = header.getUint16(position + 4, Endian.little);
+        // Padding up to the end of the ring
+        if (deviceIdLength != 0xFFFF) {
+          final characteristicIdLength =
+              header.getUint16(position + 6, Endian.little);
+          final deviceIdStart = position + 16;
+          final characteristicIdStart = deviceIdStart + deviceIdLength;
+          final valueStart = characteristicIdStart + characteristicIdLength;
+          records.add(WriteRingRecord(
+            deviceId: utf8.decode(Uint8List.sublistView(
+                bytes, deviceIdStart, characteristicIdStart)),
+            characteristicId: utf8.decode(Uint8List.sublistView(
+                bytes, characteristicIdStart, valueStart)),
+            offset: header.getUint32(position + 8, Endian.little),
+            value: Uint8List.sublistView(bytes, valueStart,
+                valueStart + header.getUint32(position + 12, Endian.little)),
+          ));
+        }
+        position += recordLength;
+      }
+      try {
+        if (records.isNotEmpty) onRecords(records);
+      } finally {
+        _writeRingRelease(readable);
+      }
+      // The callback may have stopped the ring
+      if (_writeRingPort == null) return;
+    }
+  }
+
+  Uint8List _encode(String id) {
+    if (_encodedIds.length > 256) _encodedIds.clear();
+    return _encodedIds.putIfAbsent(id, () => Uint8List.fromList(utf8.encode(id)));
+  }
+
+  Pointer<Uint8> _at(int offset) =>
+      Pointer<Uint8>.fromAddress(_buffer.address + offset);
+
+  void _reserve(int size) {
+    if (size <= _capacity) return;
+    var capacity = _capacity == 0 ? 256 : _capacity;
+    while (capacity < size) {
+      capacity *= 2;
+    }
+    if (_buffer != nullptr) _freeBuffer(_buffer);
+    _buffer = _allocBuffer(capacity);
+    if (_buffer == nullptr) {
+      _capacity = 0;
+      throw PlatformException(
+          code: 'error', message: 'Failed to allocate $capacity bytes');
+    }
+    _capacity = capacity;
+  }
+}
@@ -224,6 +224,288 @@ class ManufacturerData {
   }
 }
 
+class WriteStreamConfig {
+  WriteStreamConfig({
+    required this.maxBatchCount,
+    required this.maxBatchBytes,
+    required this.maxLatencyMs,
+    required this.capacityBytes,
+  });
+
+  int maxBatchCount;
+
+  int maxBatchBytes;
+
+  int maxLatencyMs;
+
+  int capacityBytes;
+
+  Object encode() {
+    return <Object?>[
+      maxBatchCount,
+      maxBatchBytes,
+      maxLatencyMs,
+      capacityBytes,
+    ];
+  }
+
+  static WriteStreamConfig decode(Object result) {
+    result as List<Object?>;
+    return WriteStreamConfig(
+      maxBatchCount: result[0]! as int,
+      maxBatchBytes: result[1]! as int,
+      maxLatencyMs: result[2]! as int,
+      capacityBytes: result[3]! as int,
+    );
+  }
+}
+
+class WriteStreamBatch {
+  WriteStreamBatch({
+    required this.deviceId,
+    required this.characteristicId,
+    required this.data,
+    required this.lengths,
+    required this.droppedPackets,
+    required this.droppedBytes,
+  });
+
+  String deviceId;
+
+  String characteristicId;
+
+  Uint8List data;
+
+  List<int> lengths;
+
+  int droppedPackets;
+
+  int droppedBytes;
+
+  Object encode() {
+    return <Object?>[
+      deviceId,
+      characteristicId,
+      data,
+      lengths,
+      droppedPackets,
+      droppedBytes,
+    ];
+  }
+
+  static WriteStreamBatch decode(Object result) {
+    result as List<Object?>;
+    return WriteStreamBatch(
+      deviceId: result[0]! as String,
+      characteristicId: result[1]! as String,
+      data: result[2]! as Uint8List,
+      lengths: (result[3] as List<Object?>?)!.cast<int>(),
+      droppedPackets: result[4]! as int,
+      droppedBytes: result[5]! as int,
+    );
+  }
+}
+
+class CharacteristicWritePolicy {
+  CharacteristicWritePolicy({
+    required this.acknowledgeImmediately,
+    this.minLength,
+    this.maxLength,
+    this.allowedOffsets,
+  });
+
+  bool acknowledgeImmediately;
+
+  int? minLength;
+
+  int? maxLength;
+
+  List<int>? allowedOffsets;
+
+  Object encode() {
+    return <Object?>[
+      acknowledgeImmediately,
+      minLength,
+      maxLength,
+      allowedOffsets,
+    ];
+  }
+
+  static CharacteristicWritePolicy decode(Object result) {
+    result as List<Object?>;
+    return CharacteristicWritePolicy(
+      acknowledgeImmediately: result[0]! as bool,
+      minLength: result[1] as int?,
+      maxLength: result[2] as int?,
+      allowedOffsets: (result[3] as List<Object?>?)?.cast<int>(),
+    );
+  }
+}
+
+class WriteBatchPolicy {
+  WriteBatchPolicy({
+    required this.maxCount,
+    required this.maxBytes,
+    required this.maxLatencyMs,
+  });
+
+  int maxCount;
+
+  int maxBytes;
+
+  int maxLatencyMs;
+
+  Object encode() {
+    return <Object?>[
+      maxCount,
+      maxBytes,
+      maxLatencyMs,
+    ];
+  }
+
+  static WriteBatchPolicy decode(Object result) {
+    result as List<Object?>;
+    return WriteBatchPolicy(
+      maxCount: result[0]! as int,
+      maxBytes: result[1]! as int,
+      maxLatencyMs: result[2]! as int,
+    );
+  }
+}
+
+class WriteRequestBatch {
+  WriteRequestBatch({
+    required this.deviceIds,
+    required this.characteristicIds,
+    required this.offsets,
+    required this.values,
+    required this.lengths,
+  });
+
+  List<String> deviceIds;
+
+  List<String> characteristicIds;
+
+  List<int> offsets;
+
+  Uint8List values;
+
+  List<int> lengths;
+
+  Object encode() {
+    return <Object?>[
+      deviceIds,
+      characteristicIds,
+      offsets,
+      values,
+      lengths,
+    ];
+  }
+
+  static WriteRequestBatch decode(Object result) {
+    result as List<Object?>;
+    return WriteRequestBatch(
+      deviceIds: (result[0] as List<Object?>?)!.cast<String>(),
+      characteristicIds: (result[1] as List<Object?>?)!.cast<String>(),
+      offsets: (result[2] as List<Object?>?)!.cast<int>(),
+      values: result[3]! as Uint8List,
+      lengths: (result[4] as List<Object?>?)!.cast<int>(),
+    );
+  }
+}
+
+class AdvertisementSet {
+  AdvertisementSet({
+    required this.id,
+    required this.services,
+    this.localName,
+    this.manufacturerData,
+    required this.connectable,
+    required this.dwellMs,
+    required this.priority,
+  });
+
+  String id;
+
+  List<String> services;
+
+  String? localName;
+
+  ManufacturerData? manufacturerData;
+
+  bool connectable;
+
+  int dwellMs;
+
+  int priority;
+
+  Object encode() {
+    return <Object?>[
+      id,
+      services,
+      localName,
+      manufacturerData,
+      connectable,
+      dwellMs,
+      priority,
+    ];
+  }
+
+  static AdvertisementSet decode(Object result) {
+    result as List<Object?>;
+    return AdvertisementSet(
+      id: result[0]! as String,
+      services: (result[1] as List<Object?>?)!.cast<String>(),
+      localName: result[2] as String?,
+      manufacturerData: result[3] as ManufacturerData?,
+      connectable: result[4]! as bool,
+      dwellMs: result[5]! as int,
+      priority: result[6]! as int,
+    );
+  }
+}
+
+class AdvertisementSetStats {
+  AdvertisementSetStats({
+    required this.id,
+    required this.slots,
+    required this.failures,
+    required this.airtimeMicros,
+    required this.airtimeShare,
+  });
+
+  String id;
+
+  int slots;
+
+  int failures;
+
+  int airtimeMicros;
+
+  double airtimeShare;
+
+  Object encode() {
+    return <Object?>[
+      id,
+      slots,
+      failures,
+      airtimeMicros,
+      airtimeShare,
+    ];
+  }
+
+  static AdvertisementSetStats decode(Object result) {
+    result as List<Object?>;
+    return AdvertisementSetStats(
+      id: result[0]! as String,
+      slots: result[1]! as int,
+      failures: result[2]! as int,
+      airtimeMicros: result[3]! as int,
+      airtimeShare: result[4]! as double,
+    );
+  }
+}
+
 
 class _PigeonCodec extends StandardMessageCodec {
   const _PigeonCodec();
@@ -253,6 +535,27 @@ class _PigeonCodec extends StandardMessageCodec {
     }    else if (value is ManufacturerData) {
       buffer.putUint8(135);
       writeValue(buffer, value.encode());
+    }    else if (value is WriteStreamConfig) {
+      buffer.putUint8(136);
+      writeValue(buffer, value.encode());
+    }    else if (value is WriteStreamBatch) {
+      buffer.putUint8(137);
+      writeValue(buffer, value.encode());
+    }    else if (value is CharacteristicWritePolicy) {
+      buffer.putUint8(138);
+      writeValue(buffer, value.encode());
+    }    else if (value is WriteBatchPolicy) {
+      buffer.putUint8(139);
+      writeValue(buffer, value.encode());
+    }    else if (value is WriteRequestBatch) {
+      buffer.putUint8(140);
+      writeValue(buffer, value.encode());
+    }    else if (value is AdvertisementSet) {
+      buffer.putUint8(141);
+      writeValue(buffer, value.encode());
+    }    else if (value is AdvertisementSetStats) {
+      buffer.putUint8(142);
+      writeValue(buffer, value.encode());
     } else {
       super.writeValue(buffer, value);
     }
@@ -276,6 +579,20 @@ class _PigeonCodec extends StandardMessageCodec {
         return WriteRequestResult.decode(readValue(buffer)!);
       case 135: 
         return ManufacturerData.decode(readValue(buffer)!);
+      case 136: 
+        return WriteStreamConfig.decode(readValue(buffer)!);
+      case 137: 
+        return WriteStreamBatch.decode(readValue(buffer)!);
+      case 138: 
+        return CharacteristicWritePolicy.decode(readValue(buffer)!);
+      case 139: 
+        return WriteBatchPolicy.decode(readValue(buffer)!);
+      case 140: 
+        return WriteRequestBatch.decode(readValue(buffer)!);
+      case 141: 
+        return AdvertisementSet.decode(readValue(buffer)!);
+      case 142: 
+        return AdvertisementSetStats.decode(readValue(buffer)!);
       default:
         return super.readValueOfType(type, buffer);
     }
@@ -367,7 +684,7 @@ class BlePeripheralChannel {
     }
   }
 
-  Future<void> stopAdvertising() async {
+  Future<Map<String, String>> stopAdvertising() async {
     final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertising$pigeonVar_messageChannelSuffix';
     final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
       pigeonVar_channelName,
@@ -384,8 +701,13 @@ class BlePeripheralChannel {
         message: pigeonVar_replyList[1] as String?,
         details: pigeonVar_replyList[2],
       );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
     } else {
-      return;
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, String>();
     }
   }
 
@@ -509,7 +831,7 @@ class BlePeripheralChannel {
     }
   }
 
-  Future<void> startAdvertising(List<String> services, String? localName, int? timeout, ManufacturerData? manufacturerData, bool addManufacturerDataInScanResponse) async {
+  Future<Map<String, String>> startAdvertising(List<String> services, String? localName, int? timeout, ManufacturerData? manufacturerData, bool addManufacturerDataInScanResponse) async {
     final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertising$pigeonVar_messageChannelSuffix';
     final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
       pigeonVar_channelName,
@@ -526,8 +848,13 @@ class BlePeripheralChannel {
         message: pigeonVar_replyList[1] as String?,
         details: pigeonVar_replyList[2],
       );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
     } else {
-      return;
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, String>();
     }
   }
 
@@ -552,6 +879,273 @@ class BlePeripheralChannel {
       return;
     }
   }
+
+  Future<void> setWriteStreamConfig(String characteristicId, WriteStreamConfig? config) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteStreamConfig$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[characteristicId, config]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<void> setCharacteristicWritePolicy(String characteristicId, CharacteristicWritePolicy? policy) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setCharacteristicWritePolicy$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[characteristicId, policy]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<void> setWriteBatchPolicy(WriteBatchPolicy? policy) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteBatchPolicy$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[policy]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<Map<String, String>> addServices(List<BleService> services) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addServices$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[services]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, String>();
+    }
+  }
+
+  Future<Map<String, String>> loadGattDatabase(String path) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.loadGattDatabase$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[path]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, String>();
+    }
+  }
+
+  Future<Map<String, String>> applyGattDatabase(String path) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.applyGattDatabase$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[path]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, String>();
+    }
+  }
+
+  Future<Map<String, int>> getNativeStats() async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getNativeStats$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(null) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as Map<Object?, Object?>?)!.cast<String, int>();
+    }
+  }
+
+  Future<void> startAdvertisementRotation(List<AdvertisementSet> sets) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertisementRotation$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[sets]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<void> stopAdvertisementRotation() async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertisementRotation$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(null) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
+
+  Future<List<AdvertisementSetStats>> getAdvertisementRotationStats() async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getAdvertisementRotationStats$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(null) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else if (pigeonVar_replyList[0] == null) {
+      throw PlatformException(
+        code: 'null-error',
+        message: 'Host platform returned null value for non-null return value.',
+      );
+    } else {
+      return (pigeonVar_replyList[0] as List<Object?>?)!.cast<AdvertisementSetStats>();
+    }
+  }
+
+  Future<void> updateAdvertisingData(String? localName, ManufacturerData? manufacturerData) async {
+    final String pigeonVar_channelName = 'dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateAdvertisingData$pigeonVar_messageChannelSuffix';
+    final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final List<Object?>? pigeonVar_replyList =
+        await pigeonVar_channel.send(<Object?>[localName, manufacturerData]) as List<Object?>?;
+    if (pigeonVar_replyList == null) {
+      throw _createConnectionError(pigeonVar_channelName);
+    } else if (pigeonVar_replyList.length > 1) {
+      throw PlatformException(
+        code: pigeonVar_replyList[0]! as String,
+        message: pigeonVar_replyList[1] as String?,
+        details: pigeonVar_replyList[2],
+      );
+    } else {
+      return;
+    }
+  }
 }
 
 /// Native -> Flutter
@@ -576,6 +1170,10 @@ abstract class BleCallback {
 
   void onBondStateChange(String deviceId, BondState bondState);
 
+  void onWriteStream(WriteStreamBatch batch);
+
+  void onWriteRequestsBatch(WriteRequestBatch batch);
+
   static void setUp(BleCallback? api, {BinaryMessenger? binaryMessenger, String messageChannelSuffix = '',}) {
     messageChannelSuffix = messageChannelSuffix.isNotEmpty ? '.$messageChannelSuffix' : '';
     {
@@ -835,5 +1433,55 @@ abstract class BleCallback {
         });
       }
     }
+    {
+      final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+          'dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream$messageChannelSuffix', pigeonChannelCodec,
+          binaryMessenger: binaryMessenger);
+      if (api == null) {
+        pigeonVar_channel.setMessageHandler(null);
+      } else {
+        pigeonVar_channel.setMessageHandler((Object? message) async {
+          assert(message != null,
+          'Argument for dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream was null.');
+          final List<Object?> args = (message as List<Object?>?)!;
+          final WriteStreamBatch? arg_batch = (args[0] as WriteStreamBatch?);
+          assert(arg_batch != null,
+              'Argument for dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream was null, expected non-null WriteStreamBatch.');
+          try {
+            api.onWriteStream(arg_batch!);
+            return wrapResponse(empty: true);
+          } on PlatformException catch (e) {
+            return wrapResponse(error: e);
+          }          catch (e) {
+            return wrapResponse(error: PlatformException(code: 'error', message: e.toString()));
+          }
+        });
+      }
+    }
+    {
+      final BasicMessageChannel<Object?> pigeonVar_channel = BasicMessageChannel<Object?>(
+          'dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch$messageChannelSuffix', pigeonChannelCodec,
+          binaryMessenger: binaryMessenger);
+      if (api == null) {
+        pigeonVar_channel.setMessageHandler(null);
+      } else {
+        pigeonVar_channel.setMessageHandler((Object? message) async {
+          assert(message != null,
+          'Argument for dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch was null.');
+          final List<Object?> args = (message as List<Object?>?)!;
+          final WriteRequestBatch? arg_batch = (args[0] as WriteRequestBatch?);
+          assert(arg_batch != null,
+              'Argument for dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch was null, expected non-null WriteRequestBatch.');
+          try {
+            api.onWriteRequestsBatch(arg_batch!);
+            return wrapResponse(empty: true);
+          } on PlatformException catch (e) {
+            return wrapResponse(error: e);
+          }          catch (e) {
+            return wrapResponse(error: PlatformException(code: 'error', message: e.toString()));
+          }
+        });
+      }
+    }
   }
 }
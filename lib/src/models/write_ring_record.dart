@@ -0,0 +1,19 @@
+import 'dart:typed_data';
+
+/// A writeWithoutResponse request read from the native write ring
+class WriteRingRecord {
+  const WriteRingRecord({
+    required this.deviceId,
+    required this.characteristicId,
+    required this.offset,
+    required this.value,
+  });
+
+  final String deviceId;
+  final String characteristicId;
+  final int offset;
+
+  /// View into native memory, only valid until the callback returns
+  /// Copy it with `Uint8List.fromList` to keep it
+  final Uint8List value;
+}
@@ -16,6 +16,8 @@ class BleCallbackHandler extends BleCallback {
   ServiceAddedCallback? serviceAdded;
   WriteRequestCallback? writeRequest;
   MtuChangeCallback? mtuChangeCallback;
+  WriteStreamCallback? writeStream;
+  WriteRequestsBatchCallback? writeRequestsBatch;
 
   final serviceResultStreamController =
       StreamController<({String serviceId, String? error})>.broadcast();
@@ -58,10 +60,10 @@ class BleCallbackHandler extends BleCallback {
     int offset,
     Uint8List? value,
   ) {
-    // Windows crash if return value is null
+    // Windows crash if return value is null, serve the characteristic value by default
     return readRequest?.call(deviceId, characteristicId, offset, value) ??
         ReadRequestResult(
-          value: Uint8List.fromList([0]),
+          value: value ?? Uint8List.fromList([0]),
         );
   }
 
@@ -81,4 +83,28 @@ class BleCallbackHandler extends BleCallback {
   @override
   void onMtuChange(String deviceId, int mtu) =>
       mtuChangeCallback?.call(deviceId, mtu);
+
+  @override
+  void onWriteStream(WriteStreamBatch batch) => writeStream?.call(batch);
+
+  @override
+  void onWriteRequestsBatch(WriteRequestBatch batch) {
+    final batchCallback = writeRequestsBatch;
+    if (batchCallback != null) {
+      batchCallback(batch);
+      return;
+    }
+    // Fan out to the write request callback, results are ignored for writeWithoutResponse
+    int start = 0;
+    for (int i = 0; i < batch.lengths.length; i++) {
+      final end = start + batch.lengths[i];
+      writeRequest?.call(
+        batch.deviceIds[i],
+        batch.characteristicIds[i],
+        batch.offsets[i],
+        Uint8List.sublistView(batch.values, start, end),
+      );
+      start = end;
+    }
+  }
 }
@@ -1,7 +1,9 @@
 import 'dart:async';
 
 import 'package:ble_peripheral/ble_peripheral.dart';
+import 'package:ble_peripheral/src/ffi/ble_peripheral_ffi.dart';
 import 'package:ble_peripheral/src/pigeon/ble_callback_handler.dart';
+import 'package:ble_peripheral/src/pigeon/hot_message_codec.dart';
 import 'package:ble_peripheral/src/ble_peripheral_interface.dart';
 import 'package:flutter/foundation.dart';
 
@@ -19,6 +21,9 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
   Future initialize() async {
     await _channel.initialize();
     BleCallback.setUp(_callbackHandler);
+    if (defaultTargetPlatform == TargetPlatform.windows) {
+      HotMessageChannels.setUp(_callbackHandler);
+    }
   }
 
   /// check if blePeripheral is supported on the device
@@ -62,6 +67,105 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
     await completer.future;
   }
 
+  /// Add all [services] and get the error of every failed service by its uuid
+  /// Windows builds the services in one native pipeline, other platforms add them
+  /// one after another using [addService] with [timeout]
+  @override
+  Future<Map<String, String>> addServices(
+    List<BleService> services, {
+    Duration? timeout,
+  }) async {
+    if (defaultTargetPlatform == TargetPlatform.windows) {
+      return _channel.addServices(services);
+    }
+    final errors = <String, String>{};
+    for (final service in services) {
+      try {
+        await addService(service, timeout: timeout);
+      } catch (e) {
+        errors[service.uuid] = e.toString();
+      }
+    }
+    return errors;
+  }
+
+  /// Only available on Windows
+  @override
+  Future<Map<String, String>> loadGattDatabase(String path) =>
+      _channel.loadGattDatabase(path);
+
+  /// Only available on Windows
+  @override
+  Future<Map<String, String>> applyGattDatabase(String path) =>
+      _channel.applyGattDatabase(path);
+
+  /// Only available on Windows
+  @override
+  Future<Map<String, int>> getNativeStats() => _channel.getNativeStats();
+
+  /// Only available on Windows
+  @override
+  Future<void> startAdvertisementRotation(List<AdvertisementSet> sets) =>
+      _channel.startAdvertisementRotation(sets);
+
+  /// Only available on Windows
+  @override
+  Future<void> stopAdvertisementRotation() =>
+      _channel.stopAdvertisementRotation();
+
+  /// Only available on Windows
+  @override
+  Future<List<AdvertisementSetStats>> getAdvertisementRotationStats() =>
+      _channel.getAdvertisementRotationStats();
+
+  /// Only available on Windows
+  @override
+  Future<void> updateAdvertisingData({
+    String? localName,
+    ManufacturerData? manufacturerData,
+  }) =>
+      _channel.updateAdvertisingData(localName, manufacturerData);
+
+  /// Only available on Windows
+  @override
+  void updateCharacteristicSync({
+    required String characteristicId,
+    required Uint8List value,
+    String? deviceId,
+  }) {
+    if (defaultTargetPlatform != TargetPlatform.windows) {
+      throw UnsupportedError(
+          'updateCharacteristicSync is only available on Windows');
+    }
+    BlePeripheralFfi.instance.notifyValue(
+      characteristicId: characteristicId,
+      value: value,
+      deviceId: deviceId,
+    );
+  }
+
+  /// Only available on Windows
+  @override
+  void startWriteRing({
+    required WriteRingCallback onRecords,
+    int capacity = 1 << 20,
+  }) {
+    if (defaultTargetPlatform != TargetPlatform.windows) {
+      throw UnsupportedError('startWriteRing is only available on Windows');
+    }
+    BlePeripheralFfi.instance
+        .startWriteRing(capacity: capacity, onRecords: onRecords);
+  }
+
+  /// Only available on Windows
+  @override
+  void stopWriteRing() {
+    if (defaultTargetPlatform != TargetPlatform.windows) {
+      throw UnsupportedError('stopWriteRing is only available on Windows');
+    }
+    BlePeripheralFfi.instance.stopWriteRing();
+  }
+
   /// Remove a service from the peripheral
   @override
   Future<void> removeService(String serviceId) =>
@@ -82,13 +186,17 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
     required Uint8List value,
     String? deviceId,
   }) {
+    if (defaultTargetPlatform == TargetPlatform.windows) {
+      return HotMessageChannels.updateCharacteristic(
+          characteristicId: characteristicId, value: value, deviceId: deviceId);
+    }
     return _channel.updateCharacteristic(characteristicId, value, deviceId);
   }
 
   /// Start advertising with the given services and local name
   /// make sure to add services before calling this method
   @override
-  Future<void> startAdvertising({
+  Future<Map<String, String>> startAdvertising({
     required List<String> services,
     String? localName,
     int? timeout,
@@ -109,7 +217,30 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
 
   /// Stop advertising
   @override
-  Future<void> stopAdvertising() => _channel.stopAdvertising();
+  Future<Map<String, String>> stopAdvertising() => _channel.stopAdvertising();
+
+  /// Only available on Windows
+  @override
+  Future<void> setWriteStreamConfig({
+    required String characteristicId,
+    WriteStreamConfig? config,
+  }) {
+    return _channel.setWriteStreamConfig(characteristicId, config);
+  }
+
+  /// Only available on Windows
+  @override
+  Future<void> setCharacteristicWritePolicy({
+    required String characteristicId,
+    CharacteristicWritePolicy? policy,
+  }) {
+    return _channel.setCharacteristicWritePolicy(characteristicId, policy);
+  }
+
+  /// Only available on Windows
+  @override
+  Future<void> setWriteBatchPolicy(WriteBatchPolicy? policy) =>
+      _channel.setWriteBatchPolicy(policy);
 
   /// Get the callback when advertising is started or stopped
   @override
@@ -133,7 +264,8 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
           CharacteristicSubscriptionChangeCallback callback) =>
       _callbackHandler.characteristicSubscriptionChange = callback;
 
-  /// Only available on Android
+  /// Only available on Android/Windows
+  /// On Windows, a device is reported connected once it sends a request or subscribes
   @override
   void setConnectionStateChangeCallback(
           ConnectionStateChangeCallback callback) =>
@@ -146,8 +278,12 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
 
   /// Get the callback when a read request is made
   @override
-  void setReadRequestCallback(ReadRequestCallback callback) =>
-      _callbackHandler.readRequest = callback;
+  void setReadRequestCallback(ReadRequestCallback? callback) {
+    _callbackHandler.readRequest = callback;
+    if (defaultTargetPlatform == TargetPlatform.windows) {
+      unawaited(HotMessageChannels.forwardReadRequests(callback != null));
+    }
+  }
 
   /// Get the callback when a service is added
   @override
@@ -158,4 +294,14 @@ class BlePeripheralPigeon extends BlePeripheralInterface {
   @override
   void setWriteRequestCallback(WriteRequestCallback callback) =>
       _callbackHandler.writeRequest = callback;
+
+  /// Only available on Windows
+  @override
+  void setWriteStreamCallback(WriteStreamCallback callback) =>
+      _callbackHandler.writeStream = callback;
+
+  /// Only available on Windows
+  @override
+  void setWriteRequestsBatchCallback(WriteRequestsBatchCallback callback) =>
+      _callbackHandler.writeRequestsBatch = callback;
 }
@@ -0,0 +1,155 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:ble_peripheral/ble_peripheral.dart';
+import 'package:flutter/services.dart';
+
+/// Read requests, write requests and updateCharacteristic on Windows,
+/// carried on raw channels in the fixed layout of windows/hot_message_codec.h
+/// instead of Pigeon, everything else keeps using the generated channels
+class HotMessageChannels {
+  static const _readRequest = BasicMessageChannel<ByteData?>(
+      'ble_peripheral/binary/onReadRequest', BinaryCodec());
+  static const _writeRequest = BasicMessageChannel<ByteData?>(
+      'ble_peripheral/binary/onWriteRequest', BinaryCodec());
+  static const _updateCharacteristic = BasicMessageChannel<ByteData?>(
+      'ble_peripheral/binary/updateCharacteristic', BinaryCodec());
+  static const _readRequestCallback = BasicMessageChannel<ByteData?>(
+      'ble_peripheral/binary/readRequestCallback', BinaryCodec());
+
+  static const _requestHeaderSize = 16;
+  static const _resultHeaderSize = 24;
+  static const _nullValue = 0xFFFFFFFF;
+  static const _nullId = 0xFFFF;
+
+  static const _nullResult = 1;
+  static const _hasValue = 2;
+  static const _hasOffset = 4;
+  static const _hasStatus = 8;
+  static const _error = 16;
+
+  static void setUp(BleCallback handler) {
+    _readRequest.setMessageHandler((message) async {
+      try {
+        final request = _AttributeRequest.decode(message!);
+        final result = handler.onReadRequest(request.deviceId,
+            request.characteristicId, request.offset, request.value);
+        return result == null
+            ? _encodeResult(_nullResult)
+            : _encodeResult(_hasValue, result.value, result.offset,
+                result.status);
+      } catch (e) {
+        return _encodeError(e);
+      }
+    });
+    _writeRequest.setMessageHandler((message) async {
+      try {
+        final request = _AttributeRequest.decode(message!);
+        final result = handler.onWriteRequest(request.deviceId,
+            request.characteristicId, request.offset, request.value);
+        return result == null
+            ? _encodeResult(_nullResult)
+            : _encodeResult(result.value == null ? 0 : _hasValue,
+                result.value, result.offset, result.status);
+      } catch (e) {
+        return _encodeError(e);
+      }
+    });
+  }
+
+  /// Tells the plugin whether to forward reads of characteristics with a value
+  /// to onReadRequest instead of answering them natively
+  static Future<void> forwardReadRequests(bool forward) async {
+    await _readRequestCallback
+        .send(ByteData.sublistView(Uint8List.fromList([forward ? 1 : 0])));
+  }
+
+  static Future<void> updateCharacteristic({
+    required String characteristicId,
+    required Uint8List value,
+    String? deviceId,
+  }) async {
+    final characteristic = utf8.encode(characteristicId);
+    final device = deviceId == null ? null : utf8.encode(deviceId);
+    final deviceLength = device?.length ?? 0;
+    final bytes = Uint8List(_requestHeaderSize +
+        deviceLength +
+        characteristic.length +
+        value.length);
+    ByteData.sublistView(bytes)
+      ..setUint16(0, device == null ? _nullId : deviceLength, Endian.little)
+      ..setUint16(2, characteristic.length, Endian.little)
+      ..setUint32(4, value.length, Endian.little);
+    if (device != null) bytes.setAll(_requestHeaderSize, device);
+    bytes.setAll(_requestHeaderSize + deviceLength, characteristic);
+    bytes.setAll(
+        _requestHeaderSize + deviceLength + characteristic.length, value);
+
+    final reply = await _updateCharacteristic.send(ByteData.sublistView(bytes));
+    if (reply == null || reply.lengthInBytes == 0) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel: '
+            '"ble_peripheral/binary/updateCharacteristic".',
+      );
+    }
+    if (reply.getUint8(0) != 0) {
+      throw PlatformException(
+        code: 'error',
+        message: utf8.decode(Uint8List.sublistView(reply, 1)),
+      );
+    }
+  }
+
+  static ByteData _encodeResult(int flags,
+      [Uint8List? value, int? offset, int? status]) {
+    final valueLength = value?.length ?? 0;
+    final bytes = Uint8List(_resultHeaderSize + valueLength);
+    if (offset != null) flags |= _hasOffset;
+    if (status != null) flags |= _hasStatus;
+    final header = ByteData.sublistView(bytes)
+      ..setUint8(0, flags)
+      ..setUint32(4, valueLength, Endian.little)
+      ..setInt64(8, offset ?? 0, Endian.little)
+      ..setInt64(16, status ?? 0, Endian.little);
+    if (value != null) bytes.setAll(_resultHeaderSize, value);
+    return header;
+  }
+
+  static ByteData _encodeError(Object error) {
+    final message = Uint8List.fromList(utf8.encode(error.toString()));
+    return _encodeResult(_error, message);
+  }
+}
+
+class _AttributeRequest {
+  _AttributeRequest(
+      this.deviceId, this.characteristicId, this.offset, this.value);
+
+  final String deviceId;
+  final String characteristicId;
+  final int offset;
+  final Uint8List? value;
+
+  static _AttributeRequest decode(ByteData message) {
+    final deviceIdLength = message.getUint16(0, Endian.little);
+    final characteristicIdLength = message.getUint16(2, Endian.little);
+    final valueLength = message.getUint32(4, Endian.little);
+    final offset = message.getInt64(8, Endian.little);
+
+    final characteristicIdStart =
+        HotMessageChannels._requestHeaderSize + deviceIdLength;
+    final valueStart = characteristicIdStart + characteristicIdLength;
+    return _AttributeRequest(
+      utf8.decode(Uint8List.sublistView(message,
+          HotMessageChannels._requestHeaderSize, characteristicIdStart)),
+      utf8.decode(
+          Uint8List.sublistView(message, characteristicIdStart, valueStart)),
+      offset,
+      valueLength == HotMessageChannels._nullValue
+          ? null
+          : Uint8List.sublistView(
+              message, valueStart, valueStart + valueLength),
+    );
+  }
+}
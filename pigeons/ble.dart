@@ -72,6 +72,118 @@ class ManufacturerData {
   ManufacturerData({required this.manufacturerId, required this.data});
 }
 
+// Buffer writeWithoutResponse packets natively and deliver them in batches
+class WriteStreamConfig {
+  int maxBatchCount;
+  int maxBatchBytes;
+  int maxLatencyMs;
+  int capacityBytes;
+  WriteStreamConfig({
+    required this.maxBatchCount,
+    required this.maxBatchBytes,
+    required this.maxLatencyMs,
+    required this.capacityBytes,
+  });
+}
+
+// Packets of a single device, concatenated in [data] and split by [lengths]
+class WriteStreamBatch {
+  String deviceId;
+  String characteristicId;
+  Uint8List data;
+  List<int> lengths;
+  int droppedPackets;
+  int droppedBytes;
+  WriteStreamBatch({
+    required this.deviceId,
+    required this.characteristicId,
+    required this.data,
+    required this.lengths,
+    required this.droppedPackets,
+    required this.droppedBytes,
+  });
+}
+
+// Validation rules of writes to a characteristic, checked natively
+class CharacteristicWritePolicy {
+  bool acknowledgeImmediately;
+  int? minLength;
+  int? maxLength;
+  List<int>? allowedOffsets;
+  CharacteristicWritePolicy({
+    required this.acknowledgeImmediately,
+    this.minLength,
+    this.maxLength,
+    this.allowedOffsets,
+  });
+}
+
+// Flush thresholds of batched writeWithoutResponse requests
+class WriteBatchPolicy {
+  int maxCount;
+  int maxBytes;
+  int maxLatencyMs;
+  WriteBatchPolicy({
+    required this.maxCount,
+    required this.maxBytes,
+    required this.maxLatencyMs,
+  });
+}
+
+// writeWithoutResponse requests in arrival order, one record per index,
+// values are concatenated in [values] and split by [lengths]
+class WriteRequestBatch {
+  List<String> deviceIds;
+  List<String> characteristicIds;
+  List<int> offsets;
+  Uint8List values;
+  List<int> lengths;
+  WriteRequestBatch({
+    required this.deviceIds,
+    required this.characteristicIds,
+    required this.offsets,
+    required this.values,
+    required this.lengths,
+  });
+}
+
+// One payload of a rotating advertisement schedule, advertised for dwellMs per slot
+// and chosen priority times per round relative to the other sets
+class AdvertisementSet {
+  String id;
+  List<String> services;
+  String? localName;
+  ManufacturerData? manufacturerData;
+  bool connectable;
+  int dwellMs;
+  int priority;
+  AdvertisementSet({
+    required this.id,
+    required this.services,
+    this.localName,
+    this.manufacturerData,
+    required this.connectable,
+    required this.dwellMs,
+    required this.priority,
+  });
+}
+
+// Measured airtime of an advertisement set since the rotation started
+class AdvertisementSetStats {
+  String id;
+  int slots;
+  int failures;
+  int airtimeMicros;
+  double airtimeShare;
+  AdvertisementSetStats({
+    required this.id,
+    required this.slots,
+    required this.failures,
+    required this.airtimeMicros,
+    required this.airtimeShare,
+  });
+}
+
 /// Flutter -> Native
 @HostApi()
 abstract class BlePeripheralChannel {
@@ -81,7 +193,9 @@ abstract class BlePeripheralChannel {
 
   bool isSupported();
 
-  void stopAdvertising();
+  // Resolves once advertising stopped, with the error of every service that failed to stop by its uuid
+  @async
+  Map<String, String> stopAdvertising();
 
   bool askBlePermission();
 
@@ -93,7 +207,9 @@ abstract class BlePeripheralChannel {
 
   List<String> getServices();
 
-  void startAdvertising(
+  // Resolves once advertising started, with the error of every service that failed to start by its uuid
+  @async
+  Map<String, String> startAdvertising(
     List<String> services,
     String? localName,
     int? timeout,
@@ -106,6 +222,57 @@ abstract class BlePeripheralChannel {
     Uint8List value,
     String? deviceId,
   );
+
+  // Windows only
+  void setWriteStreamConfig(
+    String characteristicId,
+    WriteStreamConfig? config,
+  );
+
+  // Windows only
+  void setCharacteristicWritePolicy(
+    String characteristicId,
+    CharacteristicWritePolicy? policy,
+  );
+
+  // Windows only
+  void setWriteBatchPolicy(WriteBatchPolicy? policy);
+
+  // Windows only, resolves once all services are built,
+  // with the error of every failed service by its uuid
+  @async
+  Map<String, String> addServices(List<BleService> services);
+
+  // Windows only, parses a JSON GATT database file natively and builds all its services,
+  // fails with every schema error at once, else resolves like addServices
+  @async
+  Map<String, String> loadGattDatabase(String path);
+
+  // Windows only, diffs the GATT database file against the added services,
+  // rebuilds services whose structure changed, updates values of the others and removes the missing ones
+  @async
+  Map<String, String> applyGattDatabase(String path);
+
+  // Windows only, counters of live native objects, to verify memory reaches a steady state
+  Map<String, int> getNativeStats();
+
+  // Windows only, time-slices the sets on a native thread until stopAdvertisementRotation,
+  // resolves once plain advertising stopped off the platform thread and the rotation started
+  @async
+  void startAdvertisementRotation(List<AdvertisementSet> sets);
+
+  // Resolves once the rotation is off air and its thread joined
+  @async
+  void stopAdvertisementRotation();
+
+  List<AdvertisementSetStats> getAdvertisementRotationStats();
+
+  // Windows only, replaces the local name and manufacturer data while advertising,
+  // the service advertisements keep running
+  void updateAdvertisingData(
+    String? localName,
+    ManufacturerData? manufacturerData,
+  );
 }
 
 /// Native -> Flutter
@@ -140,8 +307,14 @@ abstract class BleCallback {
 
   void onMtuChange(String deviceId, int mtu);
 
-  // Android only
+  // Android and Windows
   void onConnectionStateChange(String deviceId, bool connected);
 
   void onBondStateChange(String deviceId, BondState bondState);
+
+  // Windows only
+  void onWriteStream(WriteStreamBatch batch);
+
+  // Windows only
+  void onWriteRequestsBatch(WriteRequestBatch batch);
 }
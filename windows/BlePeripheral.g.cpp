@@ -444,6 +444,623 @@ ManufacturerData ManufacturerData::FromEncodableList(const EncodableList& list)
   return decoded;
 }
 
+// WriteStreamConfig
+
+WriteStreamConfig::WriteStreamConfig(
+  int64_t max_batch_count,
+  int64_t max_batch_bytes,
+  int64_t max_latency_ms,
+  int64_t capacity_bytes)
+ : max_batch_count_(max_batch_count),
+    max_batch_bytes_(max_batch_bytes),
+    max_latency_ms_(max_latency_ms),
+    capacity_bytes_(capacity_bytes) {}
+
+int64_t WriteStreamConfig::max_batch_count() const {
+  return max_batch_count_;
+}
+
+void WriteStreamConfig::set_max_batch_count(int64_t value_arg) {
+  max_batch_count_ = value_arg;
+}
+
+
+int64_t WriteStreamConfig::max_batch_bytes() const {
+  return max_batch_bytes_;
+}
+
+void WriteStreamConfig::set_max_batch_bytes(int64_t value_arg) {
+  max_batch_bytes_ = value_arg;
+}
+
+
+int64_t WriteStreamConfig::max_latency_ms() const {
+  return max_latency_ms_;
+}
+
+void WriteStreamConfig::set_max_latency_ms(int64_t value_arg) {
+  max_latency_ms_ = value_arg;
+}
+
+
+int64_t WriteStreamConfig::capacity_bytes() const {
+  return capacity_bytes_;
+}
+
+void WriteStreamConfig::set_capacity_bytes(int64_t value_arg) {
+  capacity_bytes_ = value_arg;
+}
+
+
+EncodableList WriteStreamConfig::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(4);
+  list.push_back(EncodableValue(max_batch_count_));
+  list.push_back(EncodableValue(max_batch_bytes_));
+  list.push_back(EncodableValue(max_latency_ms_));
+  list.push_back(EncodableValue(capacity_bytes_));
+  return list;
+}
+
+WriteStreamConfig WriteStreamConfig::FromEncodableList(const EncodableList& list) {
+  WriteStreamConfig decoded(
+    std::get<int64_t>(list[0]),
+    std::get<int64_t>(list[1]),
+    std::get<int64_t>(list[2]),
+    std::get<int64_t>(list[3]));
+  return decoded;
+}
+
+// WriteStreamBatch
+
+WriteStreamBatch::WriteStreamBatch(
+  const std::string& device_id,
+  const std::string& characteristic_id,
+  const std::vector<uint8_t>& data,
+  const EncodableList& lengths,
+  int64_t dropped_packets,
+  int64_t dropped_bytes)
+ : device_id_(device_id),
+    characteristic_id_(characteristic_id),
+    data_(data),
+    lengths_(lengths),
+    dropped_packets_(dropped_packets),
+    dropped_bytes_(dropped_bytes) {}
+
+const std::string& WriteStreamBatch::device_id() const {
+  return device_id_;
+}
+
+void WriteStreamBatch::set_device_id(std::string_view value_arg) {
+  device_id_ = value_arg;
+}
+
+
+const std::string& WriteStreamBatch::characteristic_id() const {
+  return characteristic_id_;
+}
+
+void WriteStreamBatch::set_characteristic_id(std::string_view value_arg) {
+  characteristic_id_ = value_arg;
+}
+
+
+const std::vector<uint8_t>& WriteStreamBatch::data() const {
+  return data_;
+}
+
+void WriteStreamBatch::set_data(const std::vector<uint8_t>& value_arg) {
+  data_ = value_arg;
+}
+
+
+const EncodableList& WriteStreamBatch::lengths() const {
+  return lengths_;
+}
+
+void WriteStreamBatch::set_lengths(const EncodableList& value_arg) {
+  lengths_ = value_arg;
+}
+
+
+int64_t WriteStreamBatch::dropped_packets() const {
+  return dropped_packets_;
+}
+
+void WriteStreamBatch::set_dropped_packets(int64_t value_arg) {
+  dropped_packets_ = value_arg;
+}
+
+
+int64_t WriteStreamBatch::dropped_bytes() const {
+  return dropped_bytes_;
+}
+
+void WriteStreamBatch::set_dropped_bytes(int64_t value_arg) {
+  dropped_bytes_ = value_arg;
+}
+
+
+EncodableList WriteStreamBatch::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(6);
+  list.push_back(EncodableValue(device_id_));
+  list.push_back(EncodableValue(characteristic_id_));
+  list.push_back(EncodableValue(data_));
+  list.push_back(EncodableValue(lengths_));
+  list.push_back(EncodableValue(dropped_packets_));
+  list.push_back(EncodableValue(dropped_bytes_));
+  return list;
+}
+
+WriteStreamBatch WriteStreamBatch::FromEncodableList(const EncodableList& list) {
+  WriteStreamBatch decoded(
+    std::get<std::string>(list[0]),
+    std::get<std::string>(list[1]),
+    std::get<std::vector<uint8_t>>(list[2]),
+    std::get<EncodableList>(list[3]),
+    std::get<int64_t>(list[4]),
+    std::get<int64_t>(list[5]));
+  return decoded;
+}
+
+// CharacteristicWritePolicy
+
+CharacteristicWritePolicy::CharacteristicWritePolicy(bool acknowledge_immediately)
+ : acknowledge_immediately_(acknowledge_immediately) {}
+
+CharacteristicWritePolicy::CharacteristicWritePolicy(
+  bool acknowledge_immediately,
+  const int64_t* min_length,
+  const int64_t* max_length,
+  const EncodableList* allowed_offsets)
+ : acknowledge_immediately_(acknowledge_immediately),
+    min_length_(min_length ? std::optional<int64_t>(*min_length) : std::nullopt),
+    max_length_(max_length ? std::optional<int64_t>(*max_length) : std::nullopt),
+    allowed_offsets_(allowed_offsets ? std::optional<EncodableList>(*allowed_offsets) : std::nullopt) {}
+
+bool CharacteristicWritePolicy::acknowledge_immediately() const {
+  return acknowledge_immediately_;
+}
+
+void CharacteristicWritePolicy::set_acknowledge_immediately(bool value_arg) {
+  acknowledge_immediately_ = value_arg;
+}
+
+
+const int64_t* CharacteristicWritePolicy::min_length() const {
+  return min_length_ ? &(*min_length_) : nullptr;
+}
+
+void CharacteristicWritePolicy::set_min_length(const int64_t* value_arg) {
+  min_length_ = value_arg ? std::optional<int64_t>(*value_arg) : std::nullopt;
+}
+
+void CharacteristicWritePolicy::set_min_length(int64_t value_arg) {
+  min_length_ = value_arg;
+}
+
+
+const int64_t* CharacteristicWritePolicy::max_length() const {
+  return max_length_ ? &(*max_length_) : nullptr;
+}
+
+void CharacteristicWritePolicy::set_max_length(const int64_t* value_arg) {
+  max_length_ = value_arg ? std::optional<int64_t>(*value_arg) : std::nullopt;
+}
+
+void CharacteristicWritePolicy::set_max_length(int64_t value_arg) {
+  max_length_ = value_arg;
+}
+
+
+const EncodableList* CharacteristicWritePolicy::allowed_offsets() const {
+  return allowed_offsets_ ? &(*allowed_offsets_) : nullptr;
+}
+
+void CharacteristicWritePolicy::set_allowed_offsets(const EncodableList* value_arg) {
+  allowed_offsets_ = value_arg ? std::optional<EncodableList>(*value_arg) : std::nullopt;
+}
+
+void CharacteristicWritePolicy::set_allowed_offsets(const EncodableList& value_arg) {
+  allowed_offsets_ = value_arg;
+}
+
+
+EncodableList CharacteristicWritePolicy::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(4);
+  list.push_back(EncodableValue(acknowledge_immediately_));
+  list.push_back(min_length_ ? EncodableValue(*min_length_) : EncodableValue());
+  list.push_back(max_length_ ? EncodableValue(*max_length_) : EncodableValue());
+  list.push_back(allowed_offsets_ ? EncodableValue(*allowed_offsets_) : EncodableValue());
+  return list;
+}
+
+CharacteristicWritePolicy CharacteristicWritePolicy::FromEncodableList(const EncodableList& list) {
+  CharacteristicWritePolicy decoded(
+    std::get<bool>(list[0]));
+  auto& encodable_min_length = list[1];
+  if (!encodable_min_length.IsNull()) {
+    decoded.set_min_length(std::get<int64_t>(encodable_min_length));
+  }
+  auto& encodable_max_length = list[2];
+  if (!encodable_max_length.IsNull()) {
+    decoded.set_max_length(std::get<int64_t>(encodable_max_length));
+  }
+  auto& encodable_allowed_offsets = list[3];
+  if (!encodable_allowed_offsets.IsNull()) {
+    decoded.set_allowed_offsets(std::get<EncodableList>(encodable_allowed_offsets));
+  }
+  return decoded;
+}
+
+// WriteBatchPolicy
+
+WriteBatchPolicy::WriteBatchPolicy(
+  int64_t max_count,
+  int64_t max_bytes,
+  int64_t max_latency_ms)
+ : max_count_(max_count),
+    max_bytes_(max_bytes),
+    max_latency_ms_(max_latency_ms) {}
+
+int64_t WriteBatchPolicy::max_count() const {
+  return max_count_;
+}
+
+void WriteBatchPolicy::set_max_count(int64_t value_arg) {
+  max_count_ = value_arg;
+}
+
+
+int64_t WriteBatchPolicy::max_bytes() const {
+  return max_bytes_;
+}
+
+void WriteBatchPolicy::set_max_bytes(int64_t value_arg) {
+  max_bytes_ = value_arg;
+}
+
+
+int64_t WriteBatchPolicy::max_latency_ms() const {
+  return max_latency_ms_;
+}
+
+void WriteBatchPolicy::set_max_latency_ms(int64_t value_arg) {
+  max_latency_ms_ = value_arg;
+}
+
+
+EncodableList WriteBatchPolicy::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(3);
+  list.push_back(EncodableValue(max_count_));
+  list.push_back(EncodableValue(max_bytes_));
+  list.push_back(EncodableValue(max_latency_ms_));
+  return list;
+}
+
+WriteBatchPolicy WriteBatchPolicy::FromEncodableList(const EncodableList& list) {
+  WriteBatchPolicy decoded(
+    std::get<int64_t>(list[0]),
+    std::get<int64_t>(list[1]),
+    std::get<int64_t>(list[2]));
+  return decoded;
+}
+
+// WriteRequestBatch
+
+WriteRequestBatch::WriteRequestBatch(
+  const EncodableList& device_ids,
+  const EncodableList& characteristic_ids,
+  const EncodableList& offsets,
+  const std::vector<uint8_t>& values,
+  const EncodableList& lengths)
+ : device_ids_(device_ids),
+    characteristic_ids_(characteristic_ids),
+    offsets_(offsets),
+    values_(values),
+    lengths_(lengths) {}
+
+const EncodableList& WriteRequestBatch::device_ids() const {
+  return device_ids_;
+}
+
+void WriteRequestBatch::set_device_ids(const EncodableList& value_arg) {
+  device_ids_ = value_arg;
+}
+
+
+const EncodableList& WriteRequestBatch::characteristic_ids() const {
+  return characteristic_ids_;
+}
+
+void WriteRequestBatch::set_characteristic_ids(const EncodableList& value_arg) {
+  characteristic_ids_ = value_arg;
+}
+
+
+const EncodableList& WriteRequestBatch::offsets() const {
+  return offsets_;
+}
+
+void WriteRequestBatch::set_offsets(const EncodableList& value_arg) {
+  offsets_ = value_arg;
+}
+
+
+const std::vector<uint8_t>& WriteRequestBatch::values() const {
+  return values_;
+}
+
+void WriteRequestBatch::set_values(const std::vector<uint8_t>& value_arg) {
+  values_ = value_arg;
+}
+
+
+const EncodableList& WriteRequestBatch::lengths() const {
+  return lengths_;
+}
+
+void WriteRequestBatch::set_lengths(const EncodableList& value_arg) {
+  lengths_ = value_arg;
+}
+
+
+EncodableList WriteRequestBatch::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(5);
+  list.push_back(EncodableValue(device_ids_));
+  list.push_back(EncodableValue(characteristic_ids_));
+  list.push_back(EncodableValue(offsets_));
+  list.push_back(EncodableValue(values_));
+  list.push_back(EncodableValue(lengths_));
+  return list;
+}
+
+WriteRequestBatch WriteRequestBatch::FromEncodableList(const EncodableList& list) {
+  WriteRequestBatch decoded(
+    std::get<EncodableList>(list[0]),
+    std::get<EncodableList>(list[1]),
+    std::get<EncodableList>(list[2]),
+    std::get<std::vector<uint8_t>>(list[3]),
+    std::get<EncodableList>(list[4]));
+  return decoded;
+}
+
+// AdvertisementSet
+
+AdvertisementSet::AdvertisementSet(
+  const std::string& id,
+  const EncodableList& services,
+  bool connectable,
+  int64_t dwell_ms,
+  int64_t priority)
+ : id_(id),
+    services_(services),
+    connectable_(connectable),
+    dwell_ms_(dwell_ms),
+    priority_(priority) {}
+
+AdvertisementSet::AdvertisementSet(
+  const std::string& id,
+  const EncodableList& services,
+  const std::string* local_name,
+  const ManufacturerData* manufacturer_data,
+  bool connectable,
+  int64_t dwell_ms,
+  int64_t priority)
+ : id_(id),
+    services_(services),
+    local_name_(local_name ? std::optional<std::string>(*local_name) : std::nullopt),
+    manufacturer_data_(manufacturer_data ? std::make_unique<ManufacturerData>(*manufacturer_data) : nullptr),
+    connectable_(connectable),
+    dwell_ms_(dwell_ms),
+    priority_(priority) {}
+
+AdvertisementSet::AdvertisementSet(const AdvertisementSet& other)
+ : id_(other.id_),
+    services_(other.services_),
+    local_name_(other.local_name_ ? std::optional<std::string>(*other.local_name_) : std::nullopt),
+    manufacturer_data_(other.manufacturer_data_ ? std::make_unique<ManufacturerData>(*other.manufacturer_data_) : nullptr),
+    connectable_(other.connectable_),
+    dwell_ms_(other.dwell_ms_),
+    priority_(other.priority_) {}
+
+AdvertisementSet& AdvertisementSet::operator=(const AdvertisementSet& other) {
+  id_ = other.id_;
+  services_ = other.services_;
+  local_name_ = other.local_name_;
+  manufacturer_data_ = other.manufacturer_data_ ? std::make_unique<ManufacturerData>(*other.manufacturer_data_) : nullptr;
+  connectable_ = other.connectable_;
+  dwell_ms_ = other.dwell_ms_;
+  priority_ = other.priority_;
+  return *this;
+}
+
+const std::string& AdvertisementSet::id() const {
+  return id_;
+}
+
+void AdvertisementSet::set_id(std::string_view value_arg) {
+  id_ = value_arg;
+}
+
+
+const EncodableList& AdvertisementSet::services() const {
+  return services_;
+}
+
+void AdvertisementSet::set_services(const EncodableList& value_arg) {
+  services_ = value_arg;
+}
+
+
+const std::string* AdvertisementSet::local_name() const {
+  return local_name_ ? &(*local_name_) : nullptr;
+}
+
+void AdvertisementSet::set_local_name(const std::string_view* value_arg) {
+  local_name_ = value_arg ? std::optional<std::string>(*value_arg) : std::nullopt;
+}
+
+void AdvertisementSet::set_local_name(std::string_view value_arg) {
+  local_name_ = value_arg;
+}
+
+
+const ManufacturerData* AdvertisementSet::manufacturer_data() const {
+  return manufacturer_data_.get();
+}
+
+void AdvertisementSet::set_manufacturer_data(const ManufacturerData* value_arg) {
+  manufacturer_data_ = value_arg ? std::make_unique<ManufacturerData>(*value_arg) : nullptr;
+}
+
+void AdvertisementSet::set_manufacturer_data(const ManufacturerData& value_arg) {
+  manufacturer_data_ = std::make_unique<ManufacturerData>(value_arg);
+}
+
+
+bool AdvertisementSet::connectable() const {
+  return connectable_;
+}
+
+void AdvertisementSet::set_connectable(bool value_arg) {
+  connectable_ = value_arg;
+}
+
+
+int64_t AdvertisementSet::dwell_ms() const {
+  return dwell_ms_;
+}
+
+void AdvertisementSet::set_dwell_ms(int64_t value_arg) {
+  dwell_ms_ = value_arg;
+}
+
+
+int64_t AdvertisementSet::priority() const {
+  return priority_;
+}
+
+void AdvertisementSet::set_priority(int64_t value_arg) {
+  priority_ = value_arg;
+}
+
+
+EncodableList AdvertisementSet::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(7);
+  list.push_back(EncodableValue(id_));
+  list.push_back(EncodableValue(services_));
+  list.push_back(local_name_ ? EncodableValue(*local_name_) : EncodableValue());
+  list.push_back(manufacturer_data_ ? CustomEncodableValue(*manufacturer_data_) : EncodableValue());
+  list.push_back(EncodableValue(connectable_));
+  list.push_back(EncodableValue(dwell_ms_));
+  list.push_back(EncodableValue(priority_));
+  return list;
+}
+
+AdvertisementSet AdvertisementSet::FromEncodableList(const EncodableList& list) {
+  AdvertisementSet decoded(
+    std::get<std::string>(list[0]),
+    std::get<EncodableList>(list[1]),
+    std::get<bool>(list[4]),
+    std::get<int64_t>(list[5]),
+    std::get<int64_t>(list[6]));
+  auto& encodable_local_name = list[2];
+  if (!encodable_local_name.IsNull()) {
+    decoded.set_local_name(std::get<std::string>(encodable_local_name));
+  }
+  auto& encodable_manufacturer_data = list[3];
+  if (!encodable_manufacturer_data.IsNull()) {
+    decoded.set_manufacturer_data(std::any_cast<const ManufacturerData&>(std::get<CustomEncodableValue>(encodable_manufacturer_data)));
+  }
+  return decoded;
+}
+
+// AdvertisementSetStats
+
+AdvertisementSetStats::AdvertisementSetStats(
+  const std::string& id,
+  int64_t slots,
+  int64_t failures,
+  int64_t airtime_micros,
+  double airtime_share)
+ : id_(id),
+    slots_(slots),
+    failures_(failures),
+    airtime_micros_(airtime_micros),
+    airtime_share_(airtime_share) {}
+
+const std::string& AdvertisementSetStats::id() const {
+  return id_;
+}
+
+void AdvertisementSetStats::set_id(std::string_view value_arg) {
+  id_ = value_arg;
+}
+
+
+int64_t AdvertisementSetStats::slots() const {
+  return slots_;
+}
+
+void AdvertisementSetStats::set_slots(int64_t value_arg) {
+  slots_ = value_arg;
+}
+
+
+int64_t AdvertisementSetStats::failures() const {
+  return failures_;
+}
+
+void AdvertisementSetStats::set_failures(int64_t value_arg) {
+  failures_ = value_arg;
+}
+
+
+int64_t AdvertisementSetStats::airtime_micros() const {
+  return airtime_micros_;
+}
+
+void AdvertisementSetStats::set_airtime_micros(int64_t value_arg) {
+  airtime_micros_ = value_arg;
+}
+
+
+double AdvertisementSetStats::airtime_share() const {
+  return airtime_share_;
+}
+
+void AdvertisementSetStats::set_airtime_share(double value_arg) {
+  airtime_share_ = value_arg;
+}
+
+
+EncodableList AdvertisementSetStats::ToEncodableList() const {
+  EncodableList list;
+  list.reserve(5);
+  list.push_back(EncodableValue(id_));
+  list.push_back(EncodableValue(slots_));
+  list.push_back(EncodableValue(failures_));
+  list.push_back(EncodableValue(airtime_micros_));
+  list.push_back(EncodableValue(airtime_share_));
+  return list;
+}
+
+AdvertisementSetStats AdvertisementSetStats::FromEncodableList(const EncodableList& list) {
+  AdvertisementSetStats decoded(
+    std::get<std::string>(list[0]),
+    std::get<int64_t>(list[1]),
+    std::get<int64_t>(list[2]),
+    std::get<int64_t>(list[3]),
+    std::get<double>(list[4]));
+  return decoded;
+}
+
 
 PigeonInternalCodecSerializer::PigeonInternalCodecSerializer() {}
 
@@ -474,6 +1091,27 @@ EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
     case 135: {
         return CustomEncodableValue(ManufacturerData::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
       }
+    case 136: {
+        return CustomEncodableValue(WriteStreamConfig::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 137: {
+        return CustomEncodableValue(WriteStreamBatch::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 138: {
+        return CustomEncodableValue(CharacteristicWritePolicy::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 139: {
+        return CustomEncodableValue(WriteBatchPolicy::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 140: {
+        return CustomEncodableValue(WriteRequestBatch::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 141: {
+        return CustomEncodableValue(AdvertisementSet::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
+    case 142: {
+        return CustomEncodableValue(AdvertisementSetStats::FromEncodableList(std::get<EncodableList>(ReadValue(stream))));
+      }
     default:
       return flutter::StandardCodecSerializer::ReadValueOfType(type, stream);
     }
@@ -518,6 +1156,41 @@ void PigeonInternalCodecSerializer::WriteValue(
       WriteValue(EncodableValue(std::any_cast<ManufacturerData>(*custom_value).ToEncodableList()), stream);
       return;
     }
+    if (custom_value->type() == typeid(WriteStreamConfig)) {
+      stream->WriteByte(136);
+      WriteValue(EncodableValue(std::any_cast<WriteStreamConfig>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(WriteStreamBatch)) {
+      stream->WriteByte(137);
+      WriteValue(EncodableValue(std::any_cast<WriteStreamBatch>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(CharacteristicWritePolicy)) {
+      stream->WriteByte(138);
+      WriteValue(EncodableValue(std::any_cast<CharacteristicWritePolicy>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(WriteBatchPolicy)) {
+      stream->WriteByte(139);
+      WriteValue(EncodableValue(std::any_cast<WriteBatchPolicy>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(WriteRequestBatch)) {
+      stream->WriteByte(140);
+      WriteValue(EncodableValue(std::any_cast<WriteRequestBatch>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AdvertisementSet)) {
+      stream->WriteByte(141);
+      WriteValue(EncodableValue(std::any_cast<AdvertisementSet>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AdvertisementSetStats)) {
+      stream->WriteByte(142);
+      WriteValue(EncodableValue(std::any_cast<AdvertisementSetStats>(*custom_value).ToEncodableList()), stream);
+      return;
+    }
   }
   flutter::StandardCodecSerializer::WriteValue(value, stream);
 }
@@ -561,22 +1234,163 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.isAdvertising" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.isAdvertising" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          ErrorOr<std::optional<bool>> output = api->IsAdvertising();
+          if (output.has_error()) {
+            reply(WrapError(output.error()));
+            return;
+          }
+          EncodableList wrapped;
+          auto output_optional = std::move(output).TakeValue();
+          if (output_optional) {
+            wrapped.push_back(EncodableValue(std::move(output_optional).value()));
+          } else {
+            wrapped.push_back(EncodableValue());
+          }
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.isSupported" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          ErrorOr<bool> output = api->IsSupported();
+          if (output.has_error()) {
+            reply(WrapError(output.error()));
+            return;
+          }
+          EncodableList wrapped;
+          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertising" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          api->StopAdvertising([reply](ErrorOr<EncodableMap>&& output) {
+            if (output.has_error()) {
+              reply(WrapError(output.error()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+            reply(EncodableValue(std::move(wrapped)));
+          });
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.askBlePermission" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          ErrorOr<bool> output = api->AskBlePermission();
+          if (output.has_error()) {
+            reply(WrapError(output.error()));
+            return;
+          }
+          EncodableList wrapped;
+          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addService" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_service_arg = args.at(0);
+          if (encodable_service_arg.IsNull()) {
+            reply(WrapError("service_arg unexpectedly null."));
+            return;
+          }
+          const auto& service_arg = std::any_cast<const BleService&>(std::get<CustomEncodableValue>(encodable_service_arg));
+          std::optional<FlutterError> output = api->AddService(service_arg);
+          if (output.has_value()) {
+            reply(WrapError(output.value()));
+            return;
+          }
+          EncodableList wrapped;
+          wrapped.push_back(EncodableValue());
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.removeService" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_service_id_arg = args.at(0);
+          if (encodable_service_id_arg.IsNull()) {
+            reply(WrapError("service_id_arg unexpectedly null."));
+            return;
+          }
+          const auto& service_id_arg = std::get<std::string>(encodable_service_id_arg);
+          std::optional<FlutterError> output = api->RemoveService(service_id_arg);
+          if (output.has_value()) {
+            reply(WrapError(output.value()));
+            return;
+          }
+          EncodableList wrapped;
+          wrapped.push_back(EncodableValue());
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.clearServices" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          ErrorOr<std::optional<bool>> output = api->IsAdvertising();
-          if (output.has_error()) {
-            reply(WrapError(output.error()));
+          std::optional<FlutterError> output = api->ClearServices();
+          if (output.has_value()) {
+            reply(WrapError(output.value()));
             return;
           }
           EncodableList wrapped;
-          auto output_optional = std::move(output).TakeValue();
-          if (output_optional) {
-            wrapped.push_back(EncodableValue(std::move(output_optional).value()));
-          } else {
-            wrapped.push_back(EncodableValue());
-          }
+          wrapped.push_back(EncodableValue());
           reply(EncodableValue(std::move(wrapped)));
         } catch (const std::exception& exception) {
           reply(WrapError(exception.what()));
@@ -587,11 +1401,11 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.isSupported" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getServices" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          ErrorOr<bool> output = api->IsSupported();
+          ErrorOr<EncodableList> output = api->GetServices();
           if (output.has_error()) {
             reply(WrapError(output.error()));
             return;
@@ -608,18 +1422,38 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertising" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertising" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          std::optional<FlutterError> output = api->StopAdvertising();
-          if (output.has_value()) {
-            reply(WrapError(output.value()));
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_services_arg = args.at(0);
+          if (encodable_services_arg.IsNull()) {
+            reply(WrapError("services_arg unexpectedly null."));
             return;
           }
-          EncodableList wrapped;
-          wrapped.push_back(EncodableValue());
-          reply(EncodableValue(std::move(wrapped)));
+          const auto& services_arg = std::get<EncodableList>(encodable_services_arg);
+          const auto& encodable_local_name_arg = args.at(1);
+          const auto* local_name_arg = std::get_if<std::string>(&encodable_local_name_arg);
+          const auto& encodable_timeout_arg = args.at(2);
+          const auto* timeout_arg = std::get_if<int64_t>(&encodable_timeout_arg);
+          const auto& encodable_manufacturer_data_arg = args.at(3);
+          const auto* manufacturer_data_arg = encodable_manufacturer_data_arg.IsNull() ? nullptr : &(std::any_cast<const ManufacturerData&>(std::get<CustomEncodableValue>(encodable_manufacturer_data_arg)));
+          const auto& encodable_add_manufacturer_data_in_scan_response_arg = args.at(4);
+          if (encodable_add_manufacturer_data_in_scan_response_arg.IsNull()) {
+            reply(WrapError("add_manufacturer_data_in_scan_response_arg unexpectedly null."));
+            return;
+          }
+          const auto& add_manufacturer_data_in_scan_response_arg = std::get<bool>(encodable_add_manufacturer_data_in_scan_response_arg);
+          api->StartAdvertising(services_arg, local_name_arg, timeout_arg, manufacturer_data_arg, add_manufacturer_data_in_scan_response_arg, [reply](ErrorOr<EncodableMap>&& output) {
+            if (output.has_error()) {
+              reply(WrapError(output.error()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+            reply(EncodableValue(std::move(wrapped)));
+          });
         } catch (const std::exception& exception) {
           reply(WrapError(exception.what()));
         }
@@ -629,17 +1463,32 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.askBlePermission" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateCharacteristic" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          ErrorOr<bool> output = api->AskBlePermission();
-          if (output.has_error()) {
-            reply(WrapError(output.error()));
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_characteristic_id_arg = args.at(0);
+          if (encodable_characteristic_id_arg.IsNull()) {
+            reply(WrapError("characteristic_id_arg unexpectedly null."));
+            return;
+          }
+          const auto& characteristic_id_arg = std::get<std::string>(encodable_characteristic_id_arg);
+          const auto& encodable_value_arg = args.at(1);
+          if (encodable_value_arg.IsNull()) {
+            reply(WrapError("value_arg unexpectedly null."));
+            return;
+          }
+          const auto& value_arg = std::get<std::vector<uint8_t>>(encodable_value_arg);
+          const auto& encodable_device_id_arg = args.at(2);
+          const auto* device_id_arg = std::get_if<std::string>(&encodable_device_id_arg);
+          std::optional<FlutterError> output = api->UpdateCharacteristic(characteristic_id_arg, value_arg, device_id_arg);
+          if (output.has_value()) {
+            reply(WrapError(output.value()));
             return;
           }
           EncodableList wrapped;
-          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+          wrapped.push_back(EncodableValue());
           reply(EncodableValue(std::move(wrapped)));
         } catch (const std::exception& exception) {
           reply(WrapError(exception.what()));
@@ -650,18 +1499,20 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addService" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteStreamConfig" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
           const auto& args = std::get<EncodableList>(message);
-          const auto& encodable_service_arg = args.at(0);
-          if (encodable_service_arg.IsNull()) {
-            reply(WrapError("service_arg unexpectedly null."));
+          const auto& encodable_characteristic_id_arg = args.at(0);
+          if (encodable_characteristic_id_arg.IsNull()) {
+            reply(WrapError("characteristic_id_arg unexpectedly null."));
             return;
           }
-          const auto& service_arg = std::any_cast<const BleService&>(std::get<CustomEncodableValue>(encodable_service_arg));
-          std::optional<FlutterError> output = api->AddService(service_arg);
+          const auto& characteristic_id_arg = std::get<std::string>(encodable_characteristic_id_arg);
+          const auto& encodable_config_arg = args.at(1);
+          const auto* config_arg = encodable_config_arg.IsNull() ? nullptr : &(std::any_cast<const WriteStreamConfig&>(std::get<CustomEncodableValue>(encodable_config_arg)));
+          std::optional<FlutterError> output = api->SetWriteStreamConfig(characteristic_id_arg, config_arg);
           if (output.has_value()) {
             reply(WrapError(output.value()));
             return;
@@ -678,18 +1529,20 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.removeService" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setCharacteristicWritePolicy" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
           const auto& args = std::get<EncodableList>(message);
-          const auto& encodable_service_id_arg = args.at(0);
-          if (encodable_service_id_arg.IsNull()) {
-            reply(WrapError("service_id_arg unexpectedly null."));
+          const auto& encodable_characteristic_id_arg = args.at(0);
+          if (encodable_characteristic_id_arg.IsNull()) {
+            reply(WrapError("characteristic_id_arg unexpectedly null."));
             return;
           }
-          const auto& service_id_arg = std::get<std::string>(encodable_service_id_arg);
-          std::optional<FlutterError> output = api->RemoveService(service_id_arg);
+          const auto& characteristic_id_arg = std::get<std::string>(encodable_characteristic_id_arg);
+          const auto& encodable_policy_arg = args.at(1);
+          const auto* policy_arg = encodable_policy_arg.IsNull() ? nullptr : &(std::any_cast<const CharacteristicWritePolicy&>(std::get<CustomEncodableValue>(encodable_policy_arg)));
+          std::optional<FlutterError> output = api->SetCharacteristicWritePolicy(characteristic_id_arg, policy_arg);
           if (output.has_value()) {
             reply(WrapError(output.value()));
             return;
@@ -706,11 +1559,14 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.clearServices" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.setWriteBatchPolicy" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          std::optional<FlutterError> output = api->ClearServices();
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_policy_arg = args.at(0);
+          const auto* policy_arg = encodable_policy_arg.IsNull() ? nullptr : &(std::any_cast<const WriteBatchPolicy&>(std::get<CustomEncodableValue>(encodable_policy_arg)));
+          std::optional<FlutterError> output = api->SetWriteBatchPolicy(policy_arg);
           if (output.has_value()) {
             reply(WrapError(output.value()));
             return;
@@ -727,18 +1583,26 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getServices" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.addServices" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
-          ErrorOr<EncodableList> output = api->GetServices();
-          if (output.has_error()) {
-            reply(WrapError(output.error()));
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_services_arg = args.at(0);
+          if (encodable_services_arg.IsNull()) {
+            reply(WrapError("services_arg unexpectedly null."));
             return;
           }
-          EncodableList wrapped;
-          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
-          reply(EncodableValue(std::move(wrapped)));
+          const auto& services_arg = std::get<EncodableList>(encodable_services_arg);
+          api->AddServices(services_arg, [reply](ErrorOr<EncodableMap>&& output) {
+            if (output.has_error()) {
+              reply(WrapError(output.error()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+            reply(EncodableValue(std::move(wrapped)));
+          });
         } catch (const std::exception& exception) {
           reply(WrapError(exception.what()));
         }
@@ -748,36 +1612,75 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertising" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.loadGattDatabase" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
           const auto& args = std::get<EncodableList>(message);
-          const auto& encodable_services_arg = args.at(0);
-          if (encodable_services_arg.IsNull()) {
-            reply(WrapError("services_arg unexpectedly null."));
+          const auto& encodable_path_arg = args.at(0);
+          if (encodable_path_arg.IsNull()) {
+            reply(WrapError("path_arg unexpectedly null."));
             return;
           }
-          const auto& services_arg = std::get<EncodableList>(encodable_services_arg);
-          const auto& encodable_local_name_arg = args.at(1);
-          const auto* local_name_arg = std::get_if<std::string>(&encodable_local_name_arg);
-          const auto& encodable_timeout_arg = args.at(2);
-          const auto* timeout_arg = std::get_if<int64_t>(&encodable_timeout_arg);
-          const auto& encodable_manufacturer_data_arg = args.at(3);
-          const auto* manufacturer_data_arg = encodable_manufacturer_data_arg.IsNull() ? nullptr : &(std::any_cast<const ManufacturerData&>(std::get<CustomEncodableValue>(encodable_manufacturer_data_arg)));
-          const auto& encodable_add_manufacturer_data_in_scan_response_arg = args.at(4);
-          if (encodable_add_manufacturer_data_in_scan_response_arg.IsNull()) {
-            reply(WrapError("add_manufacturer_data_in_scan_response_arg unexpectedly null."));
+          const auto& path_arg = std::get<std::string>(encodable_path_arg);
+          api->LoadGattDatabase(path_arg, [reply](ErrorOr<EncodableMap>&& output) {
+            if (output.has_error()) {
+              reply(WrapError(output.error()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+            reply(EncodableValue(std::move(wrapped)));
+          });
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.applyGattDatabase" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_path_arg = args.at(0);
+          if (encodable_path_arg.IsNull()) {
+            reply(WrapError("path_arg unexpectedly null."));
             return;
           }
-          const auto& add_manufacturer_data_in_scan_response_arg = std::get<bool>(encodable_add_manufacturer_data_in_scan_response_arg);
-          std::optional<FlutterError> output = api->StartAdvertising(services_arg, local_name_arg, timeout_arg, manufacturer_data_arg, add_manufacturer_data_in_scan_response_arg);
-          if (output.has_value()) {
-            reply(WrapError(output.value()));
+          const auto& path_arg = std::get<std::string>(encodable_path_arg);
+          api->ApplyGattDatabase(path_arg, [reply](ErrorOr<EncodableMap>&& output) {
+            if (output.has_error()) {
+              reply(WrapError(output.error()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+            reply(EncodableValue(std::move(wrapped)));
+          });
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getNativeStats" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          ErrorOr<EncodableMap> output = api->GetNativeStats();
+          if (output.has_error()) {
+            reply(WrapError(output.error()));
             return;
           }
           EncodableList wrapped;
-          wrapped.push_back(EncodableValue());
+          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
           reply(EncodableValue(std::move(wrapped)));
         } catch (const std::exception& exception) {
           reply(WrapError(exception.what()));
@@ -788,26 +1691,88 @@ void BlePeripheralChannel::SetUp(
     }
   }
   {
-    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateCharacteristic" + prepended_suffix, &GetCodec());
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.startAdvertisementRotation" + prepended_suffix, &GetCodec());
     if (api != nullptr) {
       channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
         try {
           const auto& args = std::get<EncodableList>(message);
-          const auto& encodable_characteristic_id_arg = args.at(0);
-          if (encodable_characteristic_id_arg.IsNull()) {
-            reply(WrapError("characteristic_id_arg unexpectedly null."));
+          const auto& encodable_sets_arg = args.at(0);
+          if (encodable_sets_arg.IsNull()) {
+            reply(WrapError("sets_arg unexpectedly null."));
             return;
           }
-          const auto& characteristic_id_arg = std::get<std::string>(encodable_characteristic_id_arg);
-          const auto& encodable_value_arg = args.at(1);
-          if (encodable_value_arg.IsNull()) {
-            reply(WrapError("value_arg unexpectedly null."));
+          const auto& sets_arg = std::get<EncodableList>(encodable_sets_arg);
+          api->StartAdvertisementRotation(sets_arg, [reply](std::optional<FlutterError>&& output) {
+            if (output.has_value()) {
+              reply(WrapError(output.value()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue());
+            reply(EncodableValue(std::move(wrapped)));
+          });
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.stopAdvertisementRotation" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          api->StopAdvertisementRotation([reply](std::optional<FlutterError>&& output) {
+            if (output.has_value()) {
+              reply(WrapError(output.value()));
+              return;
+            }
+            EncodableList wrapped;
+            wrapped.push_back(EncodableValue());
+            reply(EncodableValue(std::move(wrapped)));
+          });
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.getAdvertisementRotationStats" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          ErrorOr<EncodableList> output = api->GetAdvertisementRotationStats();
+          if (output.has_error()) {
+            reply(WrapError(output.error()));
             return;
           }
-          const auto& value_arg = std::get<std::vector<uint8_t>>(encodable_value_arg);
-          const auto& encodable_device_id_arg = args.at(2);
-          const auto* device_id_arg = std::get_if<std::string>(&encodable_device_id_arg);
-          std::optional<FlutterError> output = api->UpdateCharacteristic(characteristic_id_arg, value_arg, device_id_arg);
+          EncodableList wrapped;
+          wrapped.push_back(EncodableValue(std::move(output).TakeValue()));
+          reply(EncodableValue(std::move(wrapped)));
+        } catch (const std::exception& exception) {
+          reply(WrapError(exception.what()));
+        }
+      });
+    } else {
+      channel.SetMessageHandler(nullptr);
+    }
+  }
+  {
+    BasicMessageChannel<> channel(binary_messenger, "dev.flutter.pigeon.ble_peripheral.BlePeripheralChannel.updateAdvertisingData" + prepended_suffix, &GetCodec());
+    if (api != nullptr) {
+      channel.SetMessageHandler([api](const EncodableValue& message, const flutter::MessageReply<EncodableValue>& reply) {
+        try {
+          const auto& args = std::get<EncodableList>(message);
+          const auto& encodable_local_name_arg = args.at(0);
+          const auto* local_name_arg = std::get_if<std::string>(&encodable_local_name_arg);
+          const auto& encodable_manufacturer_data_arg = args.at(1);
+          const auto* manufacturer_data_arg = encodable_manufacturer_data_arg.IsNull() ? nullptr : &(std::any_cast<const ManufacturerData&>(std::get<CustomEncodableValue>(encodable_manufacturer_data_arg)));
+          std::optional<FlutterError> output = api->UpdateAdvertisingData(local_name_arg, manufacturer_data_arg);
           if (output.has_value()) {
             reply(WrapError(output.value()));
             return;
@@ -1111,4 +2076,53 @@ void BleCallback::OnBondStateChange(
   });
 }
 
+void BleCallback::OnWriteStream(
+  const WriteStreamBatch& batch_arg,
+  std::function<void(void)>&& on_success,
+  std::function<void(const FlutterError&)>&& on_error) {
+  const std::string channel_name = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteStream" + message_channel_suffix_;
+  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
+    CustomEncodableValue(batch_arg),
+  });
+  channel.Send(encoded_api_arguments, [channel_name, on_success = std::move(on_success), on_error = std::move(on_error)](const uint8_t* reply, size_t reply_size) {
+    std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);
+    const auto& encodable_return_value = *response;
+    const auto* list_return_value = std::get_if<EncodableList>(&encodable_return_value);
+    if (list_return_value) {
+      if (list_return_value->size() > 1) {
+        on_error(FlutterError(std::get<std::string>(list_return_value->at(0)), std::get<std::string>(list_return_value->at(1)), list_return_value->at(2)));
+      } else {
+        on_success();
+      }
+    } else {
+      on_error(CreateConnectionError(channel_name));
+    } 
+  });
+}
+void BleCallback::OnWriteRequestsBatch(
+  const WriteRequestBatch& batch_arg,
+  std::function<void(void)>&& on_success,
+  std::function<void(const FlutterError&)>&& on_error) {
+  const std::string channel_name = "dev.flutter.pigeon.ble_peripheral.BleCallback.onWriteRequestsBatch" + message_channel_suffix_;
+  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
+    CustomEncodableValue(batch_arg),
+  });
+  channel.Send(encoded_api_arguments, [channel_name, on_success = std::move(on_success), on_error = std::move(on_error)](const uint8_t* reply, size_t reply_size) {
+    std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);
+    const auto& encodable_return_value = *response;
+    const auto* list_return_value = std::get_if<EncodableList>(&encodable_return_value);
+    if (list_return_value) {
+      if (list_return_value->size() > 1) {
+        on_error(FlutterError(std::get<std::string>(list_return_value->at(0)), std::get<std::string>(list_return_value->at(1)), list_return_value->at(2)));
+      } else {
+        on_success();
+      }
+    } else {
+      on_error(CreateConnectionError(channel_name));
+    } 
+  });
+}
+
 }  // namespace ble_peripheral
@@ -281,6 +281,7 @@ class ManufacturerData {
   flutter::EncodableList ToEncodableList() const;
   friend class BlePeripheralChannel;
   friend class BleCallback;
+  friend class AdvertisementSet;
   friend class PigeonInternalCodecSerializer;
   int64_t manufacturer_id_;
   std::vector<uint8_t> data_;
@@ -288,6 +289,316 @@ class ManufacturerData {
 };
 
 
+// Generated class from Pigeon that represents data sent in messages.
+class WriteStreamConfig {
+ public:
+  // Constructs an object setting all fields.
+  explicit WriteStreamConfig(
+    int64_t max_batch_count,
+    int64_t max_batch_bytes,
+    int64_t max_latency_ms,
+    int64_t capacity_bytes);
+
+  int64_t max_batch_count() const;
+  void set_max_batch_count(int64_t value_arg);
+
+  int64_t max_batch_bytes() const;
+  void set_max_batch_bytes(int64_t value_arg);
+
+  int64_t max_latency_ms() const;
+  void set_max_latency_ms(int64_t value_arg);
+
+  int64_t capacity_bytes() const;
+  void set_capacity_bytes(int64_t value_arg);
+
+
+ private:
+  static WriteStreamConfig FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  int64_t max_batch_count_;
+  int64_t max_batch_bytes_;
+  int64_t max_latency_ms_;
+  int64_t capacity_bytes_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class WriteStreamBatch {
+ public:
+  // Constructs an object setting all fields.
+  explicit WriteStreamBatch(
+    const std::string& device_id,
+    const std::string& characteristic_id,
+    const std::vector<uint8_t>& data,
+    const flutter::EncodableList& lengths,
+    int64_t dropped_packets,
+    int64_t dropped_bytes);
+
+  const std::string& device_id() const;
+  void set_device_id(std::string_view value_arg);
+
+  const std::string& characteristic_id() const;
+  void set_characteristic_id(std::string_view value_arg);
+
+  const std::vector<uint8_t>& data() const;
+  void set_data(const std::vector<uint8_t>& value_arg);
+
+  const flutter::EncodableList& lengths() const;
+  void set_lengths(const flutter::EncodableList& value_arg);
+
+  int64_t dropped_packets() const;
+  void set_dropped_packets(int64_t value_arg);
+
+  int64_t dropped_bytes() const;
+  void set_dropped_bytes(int64_t value_arg);
+
+
+ private:
+  static WriteStreamBatch FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  std::string device_id_;
+  std::string characteristic_id_;
+  std::vector<uint8_t> data_;
+  flutter::EncodableList lengths_;
+  int64_t dropped_packets_;
+  int64_t dropped_bytes_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class CharacteristicWritePolicy {
+ public:
+  // Constructs an object setting all non-nullable fields.
+  explicit CharacteristicWritePolicy(bool acknowledge_immediately);
+
+  // Constructs an object setting all fields.
+  explicit CharacteristicWritePolicy(
+    bool acknowledge_immediately,
+    const int64_t* min_length,
+    const int64_t* max_length,
+    const flutter::EncodableList* allowed_offsets);
+
+  bool acknowledge_immediately() const;
+  void set_acknowledge_immediately(bool value_arg);
+
+  const int64_t* min_length() const;
+  void set_min_length(const int64_t* value_arg);
+  void set_min_length(int64_t value_arg);
+
+  const int64_t* max_length() const;
+  void set_max_length(const int64_t* value_arg);
+  void set_max_length(int64_t value_arg);
+
+  const flutter::EncodableList* allowed_offsets() const;
+  void set_allowed_offsets(const flutter::EncodableList* value_arg);
+  void set_allowed_offsets(const flutter::EncodableList& value_arg);
+
+
+ private:
+  static CharacteristicWritePolicy FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  bool acknowledge_immediately_;
+  std::optional<int64_t> min_length_;
+  std::optional<int64_t> max_length_;
+  std::optional<flutter::EncodableList> allowed_offsets_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class WriteBatchPolicy {
+ public:
+  // Constructs an object setting all fields.
+  explicit WriteBatchPolicy(
+    int64_t max_count,
+    int64_t max_bytes,
+    int64_t max_latency_ms);
+
+  int64_t max_count() const;
+  void set_max_count(int64_t value_arg);
+
+  int64_t max_bytes() const;
+  void set_max_bytes(int64_t value_arg);
+
+  int64_t max_latency_ms() const;
+  void set_max_latency_ms(int64_t value_arg);
+
+
+ private:
+  static WriteBatchPolicy FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  int64_t max_count_;
+  int64_t max_bytes_;
+  int64_t max_latency_ms_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class WriteRequestBatch {
+ public:
+  // Constructs an object setting all fields.
+  explicit WriteRequestBatch(
+    const flutter::EncodableList& device_ids,
+    const flutter::EncodableList& characteristic_ids,
+    const flutter::EncodableList& offsets,
+    const std::vector<uint8_t>& values,
+    const flutter::EncodableList& lengths);
+
+  const flutter::EncodableList& device_ids() const;
+  void set_device_ids(const flutter::EncodableList& value_arg);
+
+  const flutter::EncodableList& characteristic_ids() const;
+  void set_characteristic_ids(const flutter::EncodableList& value_arg);
+
+  const flutter::EncodableList& offsets() const;
+  void set_offsets(const flutter::EncodableList& value_arg);
+
+  const std::vector<uint8_t>& values() const;
+  void set_values(const std::vector<uint8_t>& value_arg);
+
+  const flutter::EncodableList& lengths() const;
+  void set_lengths(const flutter::EncodableList& value_arg);
+
+
+ private:
+  static WriteRequestBatch FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  flutter::EncodableList device_ids_;
+  flutter::EncodableList characteristic_ids_;
+  flutter::EncodableList offsets_;
+  std::vector<uint8_t> values_;
+  flutter::EncodableList lengths_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class AdvertisementSet {
+ public:
+  // Constructs an object setting all non-nullable fields.
+  explicit AdvertisementSet(
+    const std::string& id,
+    const flutter::EncodableList& services,
+    bool connectable,
+    int64_t dwell_ms,
+    int64_t priority);
+
+  // Constructs an object setting all fields.
+  explicit AdvertisementSet(
+    const std::string& id,
+    const flutter::EncodableList& services,
+    const std::string* local_name,
+    const ManufacturerData* manufacturer_data,
+    bool connectable,
+    int64_t dwell_ms,
+    int64_t priority);
+
+  ~AdvertisementSet() = default;
+  AdvertisementSet(const AdvertisementSet& other);
+  AdvertisementSet& operator=(const AdvertisementSet& other);
+  AdvertisementSet(AdvertisementSet&& other) = default;
+  AdvertisementSet& operator=(AdvertisementSet&& other) noexcept = default;
+  const std::string& id() const;
+  void set_id(std::string_view value_arg);
+
+  const flutter::EncodableList& services() const;
+  void set_services(const flutter::EncodableList& value_arg);
+
+  const std::string* local_name() const;
+  void set_local_name(const std::string_view* value_arg);
+  void set_local_name(std::string_view value_arg);
+
+  const ManufacturerData* manufacturer_data() const;
+  void set_manufacturer_data(const ManufacturerData* value_arg);
+  void set_manufacturer_data(const ManufacturerData& value_arg);
+
+  bool connectable() const;
+  void set_connectable(bool value_arg);
+
+  int64_t dwell_ms() const;
+  void set_dwell_ms(int64_t value_arg);
+
+  int64_t priority() const;
+  void set_priority(int64_t value_arg);
+
+
+ private:
+  static AdvertisementSet FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  std::string id_;
+  flutter::EncodableList services_;
+  std::optional<std::string> local_name_;
+  std::unique_ptr<ManufacturerData> manufacturer_data_;
+  bool connectable_;
+  int64_t dwell_ms_;
+  int64_t priority_;
+
+};
+
+
+// Generated class from Pigeon that represents data sent in messages.
+class AdvertisementSetStats {
+ public:
+  // Constructs an object setting all fields.
+  explicit AdvertisementSetStats(
+    const std::string& id,
+    int64_t slots,
+    int64_t failures,
+    int64_t airtime_micros,
+    double airtime_share);
+
+  const std::string& id() const;
+  void set_id(std::string_view value_arg);
+
+  int64_t slots() const;
+  void set_slots(int64_t value_arg);
+
+  int64_t failures() const;
+  void set_failures(int64_t value_arg);
+
+  int64_t airtime_micros() const;
+  void set_airtime_micros(int64_t value_arg);
+
+  double airtime_share() const;
+  void set_airtime_share(double value_arg);
+
+
+ private:
+  static AdvertisementSetStats FromEncodableList(const flutter::EncodableList& list);
+  flutter::EncodableList ToEncodableList() const;
+  friend class BlePeripheralChannel;
+  friend class BleCallback;
+  friend class PigeonInternalCodecSerializer;
+  std::string id_;
+  int64_t slots_;
+  int64_t failures_;
+  int64_t airtime_micros_;
+  double airtime_share_;
+
+};
+
+
 class PigeonInternalCodecSerializer : public flutter::StandardCodecSerializer {
  public:
   PigeonInternalCodecSerializer();
@@ -318,22 +629,48 @@ class BlePeripheralChannel {
   virtual std::optional<FlutterError> Initialize() = 0;
   virtual ErrorOr<std::optional<bool>> IsAdvertising() = 0;
   virtual ErrorOr<bool> IsSupported() = 0;
-  virtual std::optional<FlutterError> StopAdvertising() = 0;
+  virtual void StopAdvertising(std::function<void(ErrorOr<flutter::EncodableMap> reply)> result) = 0;
   virtual ErrorOr<bool> AskBlePermission() = 0;
   virtual std::optional<FlutterError> AddService(const BleService& service) = 0;
   virtual std::optional<FlutterError> RemoveService(const std::string& service_id) = 0;
   virtual std::optional<FlutterError> ClearServices() = 0;
   virtual ErrorOr<flutter::EncodableList> GetServices() = 0;
-  virtual std::optional<FlutterError> StartAdvertising(
+  virtual void StartAdvertising(
     const flutter::EncodableList& services,
     const std::string* local_name,
     const int64_t* timeout,
     const ManufacturerData* manufacturer_data,
-    bool add_manufacturer_data_in_scan_response) = 0;
+    bool add_manufacturer_data_in_scan_response,
+    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result) = 0;
   virtual std::optional<FlutterError> UpdateCharacteristic(
     const std::string& characteristic_id,
     const std::vector<uint8_t>& value,
     const std::string* device_id) = 0;
+  virtual std::optional<FlutterError> SetWriteStreamConfig(
+    const std::string& characteristic_id,
+    const WriteStreamConfig* config) = 0;
+  virtual std::optional<FlutterError> SetCharacteristicWritePolicy(
+    const std::string& characteristic_id,
+    const CharacteristicWritePolicy* policy) = 0;
+  virtual std::optional<FlutterError> SetWriteBatchPolicy(const WriteBatchPolicy* policy) = 0;
+  virtual void AddServices(
+    const flutter::EncodableList& services,
+    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result) = 0;
+  virtual void LoadGattDatabase(
+    const std::string& path,
+    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result) = 0;
+  virtual void ApplyGattDatabase(
+    const std::string& path,
+    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result) = 0;
+  virtual ErrorOr<flutter::EncodableMap> GetNativeStats() = 0;
+  virtual void StartAdvertisementRotation(
+    const flutter::EncodableList& sets,
+    std::function<void(std::optional<FlutterError> reply)> result) = 0;
+  virtual void StopAdvertisementRotation(std::function<void(std::optional<FlutterError> reply)> result) = 0;
+  virtual ErrorOr<flutter::EncodableList> GetAdvertisementRotationStats() = 0;
+  virtual std::optional<FlutterError> UpdateAdvertisingData(
+    const std::string* local_name,
+    const ManufacturerData* manufacturer_data) = 0;
 
   // The codec used by BlePeripheralChannel.
   static const flutter::StandardMessageCodec& GetCodec();
@@ -412,6 +749,14 @@ class BleCallback {
     const BondState& bond_state,
     std::function<void(void)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error);
+  void OnWriteStream(
+    const WriteStreamBatch& batch,
+    std::function<void(void)>&& on_success,
+    std::function<void(const FlutterError&)>&& on_error);
+  void OnWriteRequestsBatch(
+    const WriteRequestBatch& batch,
+    std::function<void(void)>&& on_success,
+    std::function<void(const FlutterError&)>&& on_error);
 
  private:
   flutter::BinaryMessenger* binary_messenger_;
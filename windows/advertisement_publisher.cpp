@@ -0,0 +1,305 @@
+#include "advertisement_publisher.h"
+
+#include "Utils.h"
+#include "logger.h"
+
+namespace ble_peripheral
+{
+  using winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisement;
+  using winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisher;
+  using winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisherStatus;
+  using winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisherStatusChangedEventArgs;
+  using winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEManufacturerData;
+  using winrt::Windows::System::Threading::ThreadPoolTimer;
+
+  namespace
+  {
+    ad::Uuid ToAdUuid(const winrt::guid &guid)
+    {
+      return ad::Uuid{
+          static_cast<uint8_t>(guid.Data1 >> 24), static_cast<uint8_t>(guid.Data1 >> 16),
+          static_cast<uint8_t>(guid.Data1 >> 8), static_cast<uint8_t>(guid.Data1),
+          static_cast<uint8_t>(guid.Data2 >> 8), static_cast<uint8_t>(guid.Data2),
+          static_cast<uint8_t>(guid.Data3 >> 8), static_cast<uint8_t>(guid.Data3),
+          guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
+          guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]};
+    }
+
+    std::string TruncatedFields(const ad::Encoded &encoded)
+    {
+      std::string names;
+      for (ad::Field field : encoded.truncated)
+        names += (names.empty() ? "" : ", ") + std::string(ad::FieldName(field));
+      return names;
+    }
+  } // namespace
+
+  AdvertisementPublisher::AdvertisementPublisher(AbortedFunction onAborted)
+      : onAborted_(std::move(onAborted)) {}
+
+  AdvertisementPublisher::~AdvertisementPublisher()
+  {
+    Stop();
+  }
+
+  ad::Fields AdvertisementPublisher::ToFields(const Config &config, bool withServiceUuids)
+  {
+    ad::Fields fields;
+    fields.flags = ad::kGeneralDiscoverableFlags;
+    if (withServiceUuids)
+    {
+      for (const auto &uuid : config.serviceUuids)
+        fields.serviceUuids.push_back(ToAdUuid(uuid));
+    }
+    fields.localName = config.localName;
+    fields.manufacturerId = config.manufacturerId;
+    fields.manufacturerData = config.manufacturerData;
+    return fields;
+  }
+
+  std::optional<std::string> AdvertisementPublisher::Validate(const Config &config, bool extendedAdvertisingSupported)
+  {
+    bool extended = false;
+    bool withServiceUuids = true;
+    return PlanLayout(config, extendedAdvertisingSupported, extended, withServiceUuids);
+  }
+
+  // Checked before anything is started, Windows would only report StartedWithoutAllAdvertisementData
+  std::optional<std::string> AdvertisementPublisher::PlanLayout(const Config &config, bool extendedAdvertisingSupported,
+                                                                bool &extended, bool &withServiceUuids)
+  {
+    if (ad::Encode(ToFields(config, true), ad::kLegacyBudget).fits())
+      return std::nullopt;
+
+    // The service advertisements carry the uuids anyway, dropping them keeps the widely supported legacy format
+    withServiceUuids = false;
+    ad::Encoded withoutServiceUuids = ad::Encode(ToFields(config, false), ad::kLegacyBudget);
+    if (withoutServiceUuids.fits())
+      return std::nullopt;
+
+    if (!extendedAdvertisingSupported)
+      return "Advertisement needs " + std::to_string(ad::EncodedSize(ToFields(config, false))) +
+             " bytes, legacy advertising allows " + std::to_string(ad::kLegacyBudget) +
+             " and the adapter does not support extended advertising, " +
+             TruncatedFields(withoutServiceUuids) + " would be truncated";
+
+    extended = true;
+    withServiceUuids = ad::Encode(ToFields(config, true), ad::kExtendedBudget).fits();
+    if (!withServiceUuids)
+    {
+      ad::Encoded extendedPayload = ad::Encode(ToFields(config, false), ad::kExtendedBudget);
+      if (!extendedPayload.fits())
+        return "Advertisement exceeds " + std::to_string(ad::kExtendedBudget) + " bytes, " +
+               TruncatedFields(extendedPayload) + " would be truncated";
+    }
+    return std::nullopt;
+  }
+
+  std::optional<std::string> AdvertisementPublisher::Start(const Config &config, bool extendedAdvertisingSupported)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StopLocked();
+    active_ = true;
+    extendedAdvertisingSupported_ = extendedAdvertisingSupported;
+    config_ = config;
+    lastPublish_ = std::chrono::steady_clock::now();
+    auto error = PublishLocked(config_);
+    if (error.has_value())
+      active_ = false;
+    return error;
+  }
+
+  std::optional<std::string> AdvertisementPublisher::Update(Config config)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_)
+      return "Not advertising";
+    config.serviceUuids = config_.serviceUuids;
+    if (auto error = Validate(config, extendedAdvertisingSupported_))
+      return error;
+
+    pendingUpdate_ = std::move(config);
+    if (updateTimer_ != nullptr)
+      return std::nullopt;
+    auto wait = lastPublish_ + kMinUpdateInterval - std::chrono::steady_clock::now();
+    if (wait.count() <= 0)
+    {
+      ApplyPendingLocked();
+      return std::nullopt;
+    }
+    uint64_t generation = ++updateGeneration_;
+    std::weak_ptr<AdvertisementPublisher> weak = weak_from_this();
+    updateTimer_ = ThreadPoolTimer::CreateTimer(
+        [weak, generation](ThreadPoolTimer const &)
+        {
+          if (auto self = weak.lock())
+            self->OnUpdateTimer(generation);
+        },
+        std::chrono::duration_cast<winrt::Windows::Foundation::TimeSpan>(wait));
+    return std::nullopt;
+  }
+
+  void AdvertisementPublisher::OnUpdateTimer(uint64_t generation)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Stopped, or stopped and restarted, while this callback was waiting for the lock
+    if (updateTimer_ == nullptr || generation != updateGeneration_)
+      return;
+    updateTimer_ = nullptr;
+    ApplyPendingLocked();
+  }
+
+  void AdvertisementPublisher::ApplyPendingLocked()
+  {
+    if (!active_ || !pendingUpdate_.has_value())
+      return;
+    config_ = std::move(*pendingUpdate_);
+    pendingUpdate_.reset();
+    lastPublish_ = std::chrono::steady_clock::now();
+    try
+    {
+      if (auto error = PublishLocked(config_))
+        BLE_LOG_ERROR("Failed to update advertisement: ", *error);
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      BLE_LOG_ERROR("Failed to update advertisement: ", e.message());
+    }
+  }
+
+  std::optional<std::string> AdvertisementPublisher::PublishLocked(const Config &config)
+  {
+    if (!config.localName.has_value() && !config.manufacturerId.has_value())
+    {
+      StopPublisher(publisher_, statusChangedToken_);
+      return std::nullopt;
+    }
+
+    bool extended = false;
+    bool withServiceUuids = true;
+    if (auto error = PlanLayout(config, extendedAdvertisingSupported_, extended, withServiceUuids))
+      return error;
+
+    auto build = [&](bool withLocalName)
+    {
+      BluetoothLEAdvertisement advertisement;
+      if (withServiceUuids)
+      {
+        for (const auto &uuid : config.serviceUuids)
+          advertisement.ServiceUuids().Append(uuid);
+      }
+      if (config.manufacturerId.has_value())
+        advertisement.ManufacturerData().Append(BluetoothLEManufacturerData(*config.manufacturerId, from_bytevc(config.manufacturerData)));
+      if (withLocalName && config.localName.has_value())
+        advertisement.LocalName(winrt::to_hstring(*config.localName));
+
+      BluetoothLEAdvertisementPublisher publisher(advertisement);
+      if (extended)
+        publisher.UseExtendedAdvertisement(true);
+      return publisher;
+    };
+
+    BluetoothLEAdvertisementPublisher publisher{nullptr};
+    try
+    {
+      publisher = build(true);
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      // Some Windows versions reserve the local name section for the system
+      if (!config.localName.has_value() || !config.manufacturerId.has_value())
+        return winrt::to_string(e.message());
+      BLE_LOG_WARNING("Local name rejected, advertising manufacturer data only: ", e.message());
+      publisher = build(false);
+    }
+
+    if (publisher_ != nullptr)
+    {
+      std::lock_guard<std::mutex> retiringLock(retiringMutex_);
+      // A third payload within one start latency, the oldest one goes right away
+      StopPublisher(retiring_, retiringToken_);
+      retiring_ = publisher_;
+      retiringToken_ = statusChangedToken_;
+      publisher_ = nullptr;
+    }
+
+    std::weak_ptr<AdvertisementPublisher> weak = weak_from_this();
+    statusChangedToken_ = publisher.StatusChanged(
+        [weak](BluetoothLEAdvertisementPublisher const &, BluetoothLEAdvertisementPublisherStatusChangedEventArgs const &args)
+        {
+          if (auto self = weak.lock())
+            self->OnStatusChanged(args);
+        });
+    publisher_ = publisher;
+    publisher_.Start();
+    BLE_LOG_DEBUG("Advertisement publisher started, ", (extended ? "extended" : "legacy"), (withServiceUuids ? "" : " without service uuids"));
+    return std::nullopt;
+  }
+
+  void AdvertisementPublisher::OnStatusChanged(BluetoothLEAdvertisementPublisherStatusChangedEventArgs const &args)
+  {
+    if (args.Status() == BluetoothLEAdvertisementPublisherStatus::Started)
+      RetirePublisher();
+    else if (args.Status() == BluetoothLEAdvertisementPublisherStatus::Aborted)
+      onAborted_(args.Error());
+  }
+
+  void AdvertisementPublisher::RetirePublisher()
+  {
+    std::lock_guard<std::mutex> lock(retiringMutex_);
+    StopPublisher(retiring_, retiringToken_);
+  }
+
+  void AdvertisementPublisher::ArmTimeout(std::chrono::milliseconds timeout, std::function<void()> onTimeout)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (timer_ != nullptr)
+      timer_.Cancel();
+    timer_ = ThreadPoolTimer::CreateTimer(
+        [onTimeout = std::move(onTimeout)](ThreadPoolTimer const &)
+        { onTimeout(); },
+        timeout);
+  }
+
+  void AdvertisementPublisher::Stop()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StopLocked();
+  }
+
+  void AdvertisementPublisher::StopLocked()
+  {
+    if (timer_ != nullptr)
+    {
+      timer_.Cancel();
+      timer_ = nullptr;
+    }
+    if (updateTimer_ != nullptr)
+    {
+      updateTimer_.Cancel();
+      updateTimer_ = nullptr;
+      ++updateGeneration_;
+    }
+    active_ = false;
+    pendingUpdate_.reset();
+    StopPublisher(publisher_, statusChangedToken_);
+    RetirePublisher();
+  }
+
+  void AdvertisementPublisher::StopPublisher(BluetoothLEAdvertisementPublisher &publisher, winrt::event_token token)
+  {
+    if (publisher == nullptr)
+      return;
+    publisher.StatusChanged(token);
+    try
+    {
+      publisher.Stop();
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      BLE_LOG_ERROR("Failed to stop advertisement publisher: ", e.message());
+    }
+    publisher = nullptr;
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <winrt/Windows.Devices.Bluetooth.h>
+#include <winrt/Windows.Devices.Bluetooth.Advertisement.h>
+#include <winrt/Windows.System.Threading.h>
+
+#include "advertising_payload.h"
+
+namespace ble_peripheral
+{
+
+    /// Publishes the fields GattServiceProvider advertising has no room for, the local name and
+    /// manufacturer data, with a BluetoothLEAdvertisementPublisher next to the connectable service advertisements.
+    /// When the payload exceeds a legacy advertisement it first leaves out the service uuids, which the service
+    /// advertisements carry anyway, and only switches to extended advertising if that still does not fit.
+    /// Windows decides what goes into the scan response, manufacturer data is always in the advertisement.
+    /// Updates are double-buffered, the new publisher goes on air before the previous one is stopped.
+    /// Must be owned by a shared_ptr, timers and publisher events only hold it weakly
+    class AdvertisementPublisher : public std::enable_shared_from_this<AdvertisementPublisher>
+    {
+    public:
+        struct Config
+        {
+            std::vector<winrt::guid> serviceUuids;
+            std::optional<std::string> localName;
+            std::optional<uint16_t> manufacturerId;
+            std::vector<uint8_t> manufacturerData;
+        };
+
+        // Called on a WinRT thread when the publisher is aborted, e.g. when the radio is turned off
+        using AbortedFunction = std::function<void(winrt::Windows::Devices::Bluetooth::BluetoothError error)>;
+
+        explicit AdvertisementPublisher(AbortedFunction onAborted);
+        ~AdvertisementPublisher();
+
+        AdvertisementPublisher(const AdvertisementPublisher &) = delete;
+        AdvertisementPublisher &operator=(const AdvertisementPublisher &) = delete;
+
+        // Nothing is published without a local name or manufacturer data.
+        // Returns an error naming the fields that would be truncated instead of starting
+        std::optional<std::string> Start(const Config &config, bool extendedAdvertisingSupported);
+        // Replaces the local name and manufacturer data, the service uuids passed to Start are kept.
+        // Applied at most once per kMinUpdateInterval, updates arriving in between only keep the newest payload
+        std::optional<std::string> Update(Config config);
+        // Whether config can be advertised at all, the same check Start makes
+        static std::optional<std::string> Validate(const Config &config, bool extendedAdvertisingSupported);
+        // Runs onTimeout on a thread pool thread once timeout elapsed, replaces a pending timeout
+        void ArmTimeout(std::chrono::milliseconds timeout, std::function<void()> onTimeout);
+        void Stop();
+
+        // Advertising data of config as the publisher sends it, including the flags Windows adds
+        static ad::Fields ToFields(const Config &config, bool withServiceUuids);
+
+        static constexpr std::chrono::milliseconds kMinUpdateInterval{100};
+
+    private:
+        // Leaves out the service uuids, then picks extended advertising as needed, returns an error if nothing fits
+        static std::optional<std::string> PlanLayout(const Config &config, bool extendedAdvertisingSupported,
+                                                     bool &extended, bool &withServiceUuids);
+        // Puts config on air, the current publisher keeps running until the new one has started
+        std::optional<std::string> PublishLocked(const Config &config);
+        void ApplyPendingLocked();
+        void OnUpdateTimer(uint64_t generation);
+        void OnStatusChanged(winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisherStatusChangedEventArgs const &args);
+        void RetirePublisher();
+        void StopLocked();
+        static void StopPublisher(winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisher &publisher,
+                                  winrt::event_token token);
+
+        std::mutex mutex_;
+        AbortedFunction onAborted_;
+        winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisher publisher_{nullptr};
+        winrt::event_token statusChangedToken_;
+        winrt::Windows::System::Threading::ThreadPoolTimer timer_{nullptr};
+
+        // Between Start and Stop, even while nothing needs a publisher
+        bool active_ = false;
+        bool extendedAdvertisingSupported_ = false;
+        Config config_;
+        std::optional<Config> pendingUpdate_;
+        std::chrono::steady_clock::time_point lastPublish_;
+        winrt::Windows::System::Threading::ThreadPoolTimer updateTimer_{nullptr};
+        // Cancel does not wait for a callback already running, it ignores timers of an older generation
+        uint64_t updateGeneration_ = 0;
+
+        // The publisher being replaced, stopped once its successor reports Started.
+        // Guarded by its own mutex, StatusChanged may be raised while mutex_ is held
+        std::mutex retiringMutex_;
+        winrt::Windows::Devices::Bluetooth::Advertisement::BluetoothLEAdvertisementPublisher retiring_{nullptr};
+        winrt::event_token retiringToken_;
+    };
+
+} // namespace ble_peripheral
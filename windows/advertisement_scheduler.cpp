@@ -0,0 +1,218 @@
+#include "advertisement_scheduler.h"
+
+#include <algorithm>
+
+#include "logger.h"
+
+namespace ble_peripheral
+{
+  using std::chrono::steady_clock;
+
+  namespace
+  {
+    // Available since Windows 10 1803, older versions fall back to the default timer resolution
+    constexpr DWORD kHighResolutionTimer = 0x00000002; // CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+  } // namespace
+
+  AdvertisementScheduler::AdvertisementScheduler(std::vector<Set> sets, bool extendedAdvertisingSupported,
+                                                 ServicesAdvertisingFunction setServicesAdvertising)
+      : sets_(std::move(sets)),
+        extendedAdvertisingSupported_(extendedAdvertisingSupported),
+        setServicesAdvertising_(std::move(setServicesAdvertising))
+  {
+    currentWeights_.assign(sets_.size(), 0);
+    for (const auto &set : sets_)
+    {
+      SetStats stats;
+      stats.id = set.id;
+      stats_.push_back(stats);
+      std::string id = set.id;
+      publishers_.push_back(std::make_shared<AdvertisementPublisher>(
+          [id](winrt::Windows::Devices::Bluetooth::BluetoothError error)
+          {
+            BLE_LOG_ERROR("Advertisement set ", id, " aborted: ", static_cast<int>(error));
+          }));
+    }
+  }
+
+  AdvertisementScheduler::~AdvertisementScheduler()
+  {
+    Stop();
+  }
+
+  std::optional<std::string> AdvertisementScheduler::Start()
+  {
+    if (sets_.empty())
+      return "No advertisement sets";
+    for (const auto &set : sets_)
+    {
+      if (set.dwell.count() <= 0)
+        return "Advertisement set " + set.id + " needs a positive dwell time";
+      if (!set.connectable && !set.config.localName.has_value() && !set.config.manufacturerId.has_value())
+        return "Advertisement set " + set.id + " has nothing to advertise, it is not connectable and has neither a local name nor manufacturer data";
+      if (auto error = AdvertisementPublisher::Validate(set.config, extendedAdvertisingSupported_))
+        return "Advertisement set " + set.id + ": " + *error;
+    }
+
+    timer_ = CreateWaitableTimerExW(nullptr, nullptr, kHighResolutionTimer, TIMER_ALL_ACCESS);
+    if (timer_ == nullptr)
+      timer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    stopEvent_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (timer_ == nullptr || stopEvent_ == nullptr)
+    {
+      Stop();
+      return "Failed to create the rotation timer, error " + std::to_string(GetLastError());
+    }
+
+    startedAt_ = steady_clock::now();
+    thread_ = std::thread(&AdvertisementScheduler::Run, this);
+    return std::nullopt;
+  }
+
+  void AdvertisementScheduler::Stop()
+  {
+    if (stopEvent_ != nullptr)
+      SetEvent(stopEvent_);
+    if (thread_.joinable())
+      thread_.join();
+    if (timer_ != nullptr)
+    {
+      CloseHandle(timer_);
+      timer_ = nullptr;
+    }
+    if (stopEvent_ != nullptr)
+    {
+      CloseHandle(stopEvent_);
+      stopEvent_ = nullptr;
+    }
+  }
+
+  std::vector<AdvertisementScheduler::SetStats> AdvertisementScheduler::Stats() const
+  {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    std::vector<SetStats> stats = stats_;
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - startedAt_);
+    for (auto &set : stats)
+      set.airtimeShare = elapsed.count() > 0 ? static_cast<double>(set.airtime.count()) / elapsed.count() : 0;
+    return stats;
+  }
+
+  void AdvertisementScheduler::Run()
+  {
+    winrt::init_apartment(winrt::apartment_type::multi_threaded);
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+
+    size_t current = kNoSet;
+    auto deadline = steady_clock::now();
+    while (WaitForSingleObject(stopEvent_, 0) != WAIT_OBJECT_0)
+    {
+      size_t next = PickNext();
+      bool onAir = Switch(current, next);
+      auto slotStart = steady_clock::now();
+      current = onAir ? next : kNoSet;
+      {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        if (onAir)
+          stats_[next].slots++;
+        else
+          stats_[next].failures++;
+      }
+
+      deadline += sets_[next].dwell;
+      // Fell a whole slot behind, e.g. the radio took long to start, restart the schedule from now
+      if (deadline <= slotStart)
+        deadline = slotStart + sets_[next].dwell;
+      WaitUntil(deadline);
+
+      if (onAir)
+      {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_[next].airtime += std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - slotStart);
+      }
+    }
+
+    TakeOffAir(current);
+    winrt::uninit_apartment();
+  }
+
+  size_t AdvertisementScheduler::PickNext()
+  {
+    int64_t total = 0;
+    size_t best = 0;
+    for (size_t i = 0; i < sets_.size(); i++)
+    {
+      int64_t weight = (std::max)<int64_t>(sets_[i].priority, 1);
+      currentWeights_[i] += weight;
+      total += weight;
+      if (currentWeights_[i] > currentWeights_[best])
+        best = i;
+    }
+    currentWeights_[best] -= total;
+    return best;
+  }
+
+  bool AdvertisementScheduler::Switch(size_t current, size_t next)
+  {
+    // A single set, or the same set twice in a row, stays on air
+    if (current == next)
+      return true;
+
+    try
+    {
+      if (current != kNoSet)
+        publishers_[current]->Stop();
+      if (servicesAdvertising_ != sets_[next].connectable)
+      {
+        setServicesAdvertising_(sets_[next].connectable);
+        servicesAdvertising_ = sets_[next].connectable;
+      }
+      if (auto error = publishers_[next]->Start(sets_[next].config, extendedAdvertisingSupported_))
+      {
+        BLE_LOG_ERROR("Advertisement set ", sets_[next].id, " failed to start: ", *error);
+        return false;
+      }
+      return true;
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      BLE_LOG_ERROR("Advertisement set switch failed: ", e.message());
+      return false;
+    }
+  }
+
+  void AdvertisementScheduler::TakeOffAir(size_t current)
+  {
+    try
+    {
+      if (current != kNoSet)
+        publishers_[current]->Stop();
+      if (servicesAdvertising_)
+        setServicesAdvertising_(false);
+      servicesAdvertising_ = false;
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      BLE_LOG_ERROR("Failed to stop advertisement set: ", e.message());
+    }
+  }
+
+  void AdvertisementScheduler::WaitUntil(steady_clock::time_point deadline)
+  {
+    auto remaining = deadline - steady_clock::now();
+    if (remaining.count() <= 0)
+      return;
+    // Negative due times are relative, in 100ns units
+    LARGE_INTEGER due;
+    due.QuadPart = -(std::max)<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100, 1);
+    if (!SetWaitableTimer(timer_, &due, 0, nullptr, nullptr, FALSE))
+    {
+      WaitForSingleObject(stopEvent_, static_cast<DWORD>(
+                                          std::chrono::duration_cast<std::chrono::milliseconds>(remaining).count()));
+      return;
+    }
+    HANDLE handles[] = {stopEvent_, timer_};
+    WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+  }
+
+} // namespace ble_peripheral
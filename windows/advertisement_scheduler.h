@@ -0,0 +1,91 @@
+#pragma once
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "advertisement_publisher.h"
+
+namespace ble_peripheral
+{
+
+    /// Time-slices advertisement sets on a dedicated thread, one set on air at a time.
+    /// Slots are picked by smooth weighted round robin with the priority as weight, so a set of priority 3
+    /// gets three slots for every slot of a set of priority 1, spread out instead of back to back.
+    /// Slot deadlines advance from the previous deadline rather than from the wakeup, so switching
+    /// overhead does not accumulate, and are waited on with a high resolution waitable timer
+    class AdvertisementScheduler
+    {
+    public:
+        struct Set
+        {
+            std::string id;
+            AdvertisementPublisher::Config config;
+            // Connectable sets turn on the advertisements of the GATT services for their slot
+            bool connectable = false;
+            std::chrono::milliseconds dwell{0};
+            int64_t priority = 1;
+        };
+
+        struct SetStats
+        {
+            std::string id;
+            int64_t slots = 0;
+            int64_t failures = 0;
+            std::chrono::microseconds airtime{0};
+            // Airtime over the time the rotation has been running, switching time counts against every set
+            double airtimeShare = 0;
+        };
+
+        // Called on the scheduler thread to start or stop advertising the GATT services
+        using ServicesAdvertisingFunction = std::function<void(bool advertise)>;
+
+        AdvertisementScheduler(std::vector<Set> sets, bool extendedAdvertisingSupported,
+                               ServicesAdvertisingFunction setServicesAdvertising);
+        ~AdvertisementScheduler();
+
+        AdvertisementScheduler(const AdvertisementScheduler &) = delete;
+        AdvertisementScheduler &operator=(const AdvertisementScheduler &) = delete;
+
+        // Checks every set before anything goes on air, returns the first problem instead of starting
+        std::optional<std::string> Start();
+        // Takes the current set off air and joins the scheduler thread
+        void Stop();
+        std::vector<SetStats> Stats() const;
+
+    private:
+        static constexpr size_t kNoSet = SIZE_MAX;
+
+        void Run();
+        size_t PickNext();
+        // Hands the air over from current to next, returns whether next went on air
+        bool Switch(size_t current, size_t next);
+        void TakeOffAir(size_t current);
+        void WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+        std::vector<Set> sets_;
+        bool extendedAdvertisingSupported_;
+        ServicesAdvertisingFunction setServicesAdvertising_;
+        std::vector<std::shared_ptr<AdvertisementPublisher>> publishers_;
+        // Smooth weighted round robin state, only touched by the scheduler thread
+        std::vector<int64_t> currentWeights_;
+        bool servicesAdvertising_ = false;
+
+        HANDLE timer_ = nullptr;
+        HANDLE stopEvent_ = nullptr;
+        std::thread thread_;
+
+        mutable std::mutex statsMutex_;
+        std::vector<SetStats> stats_;
+        std::chrono::steady_clock::time_point startedAt_;
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ble_peripheral
+{
+
+    /// Advertising data (AD) structures, encoded and decoded without any platform API,
+    /// see Core Specification Supplement part A. Every structure is a length byte, a type byte and data
+    namespace ad
+    {
+        enum Type : uint8_t
+        {
+            kFlags = 0x01,
+            kIncompleteServiceUuids16 = 0x02,
+            kCompleteServiceUuids16 = 0x03,
+            kIncompleteServiceUuids32 = 0x04,
+            kCompleteServiceUuids32 = 0x05,
+            kIncompleteServiceUuids128 = 0x06,
+            kCompleteServiceUuids128 = 0x07,
+            kShortenedLocalName = 0x08,
+            kCompleteLocalName = 0x09,
+            kServiceData16 = 0x16,
+            kServiceData128 = 0x21,
+            kManufacturerData = 0xFF,
+        };
+
+        constexpr size_t kLegacyBudget = 31;
+        constexpr size_t kExtendedBudget = 254;
+        // LE General Discoverable Mode, BR/EDR Not Supported
+        constexpr uint8_t kGeneralDiscoverableFlags = 0x06;
+
+        /// 128 bit uuid, most significant byte first like its string form
+        using Uuid = std::array<uint8_t, 16>;
+
+        constexpr Uuid FromShortUuid(uint16_t shortUuid)
+        {
+            return Uuid{0x00, 0x00, static_cast<uint8_t>(shortUuid >> 8), static_cast<uint8_t>(shortUuid),
+                        0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5f, 0x9b, 0x34, 0xfb};
+        }
+
+        // Whether uuid is a 16 bit short form of the Bluetooth base uuid
+        constexpr bool IsShortUuid(const Uuid &uuid)
+        {
+            const Uuid base = FromShortUuid(0);
+            for (size_t i = 0; i < base.size(); ++i)
+            {
+                if (i != 2 && i != 3 && uuid[i] != base[i])
+                    return false;
+            }
+            return true;
+        }
+
+        constexpr uint16_t ShortUuid(const Uuid &uuid)
+        {
+            return static_cast<uint16_t>(uuid[2] << 8 | uuid[3]);
+        }
+
+        // Bytes an AD structure with dataLength bytes of data takes
+        constexpr size_t SectionSize(size_t dataLength) { return 2 + dataLength; }
+
+        /// Fixed payloads are assembled at compile time, their budget checked with static_assert:
+        ///   constexpr auto kPayload = Concat(Section(kFlags, std::array<uint8_t, 1>{kGeneralDiscoverableFlags}),
+        ///                                    Section(kManufacturerData, std::array<uint8_t, 3>{0x4c, 0x00, 0x01}));
+        ///   static_assert(kPayload.size() <= kLegacyBudget);
+        template <size_t N>
+        constexpr std::array<uint8_t, N + 2> Section(uint8_t type, const std::array<uint8_t, N> &data)
+        {
+            static_assert(N < 255, "AD structure data is at most 254 bytes");
+            std::array<uint8_t, N + 2> section{};
+            section[0] = static_cast<uint8_t>(N + 1);
+            section[1] = type;
+            for (size_t i = 0; i < N; ++i)
+                section[i + 2] = data[i];
+            return section;
+        }
+
+        template <size_t A, size_t B>
+        constexpr std::array<uint8_t, A + B> Concat(const std::array<uint8_t, A> &first, const std::array<uint8_t, B> &second)
+        {
+            std::array<uint8_t, A + B> payload{};
+            for (size_t i = 0; i < A; ++i)
+                payload[i] = first[i];
+            for (size_t i = 0; i < B; ++i)
+                payload[A + i] = second[i];
+            return payload;
+        }
+
+        template <size_t A, size_t B, size_t... Rest>
+        constexpr auto Concat(const std::array<uint8_t, A> &first, const std::array<uint8_t, B> &second,
+                              const std::array<uint8_t, Rest> &...rest)
+        {
+            return Concat(Concat(first, second), rest...);
+        }
+
+        struct ServiceData
+        {
+            Uuid uuid;
+            std::vector<uint8_t> data;
+        };
+
+        struct Fields
+        {
+            std::optional<uint8_t> flags;
+            std::vector<Uuid> serviceUuids;
+            // Cleared by Decode for incomplete uuid lists
+            bool serviceUuidsComplete = true;
+            std::optional<std::string> localName;
+            // Cleared by Decode for a shortened local name
+            bool localNameComplete = true;
+            std::optional<uint16_t> manufacturerId;
+            std::vector<uint8_t> manufacturerData;
+            std::vector<ServiceData> serviceData;
+        };
+
+        enum class Field
+        {
+            Flags,
+            ServiceUuids,
+            LocalName,
+            ManufacturerData,
+            ServiceData,
+        };
+
+        inline const char *FieldName(Field field)
+        {
+            switch (field)
+            {
+            case Field::Flags:
+                return "flags";
+            case Field::ServiceUuids:
+                return "serviceUuids";
+            case Field::LocalName:
+                return "localName";
+            case Field::ManufacturerData:
+                return "manufacturerData";
+            case Field::ServiceData:
+                return "serviceData";
+            }
+            return "unknown";
+        }
+
+        struct Encoded
+        {
+            std::vector<uint8_t> payload;
+            // Fields left out or cut short to stay within the budget
+            std::vector<Field> truncated;
+
+            bool fits() const { return truncated.empty(); }
+        };
+
+        namespace detail
+        {
+            inline void AppendUuid(std::vector<uint8_t> &out, const Uuid &uuid)
+            {
+                // Written least significant byte first
+                if (IsShortUuid(uuid))
+                {
+                    out.push_back(uuid[3]);
+                    out.push_back(uuid[2]);
+                    return;
+                }
+                out.insert(out.end(), uuid.rbegin(), uuid.rend());
+            }
+
+            inline Uuid ReadUuid(const uint8_t *data, size_t size)
+            {
+                Uuid uuid = FromShortUuid(0);
+                // 16 and 32 bit forms replace the leading bytes of the base uuid
+                size_t offset = size == 16 ? 0 : 4 - size;
+                for (size_t i = 0; i < size; ++i)
+                    uuid[offset + size - 1 - i] = data[i];
+                return uuid;
+            }
+
+            inline void AppendSection(std::vector<uint8_t> &out, uint8_t type, const uint8_t *data, size_t size)
+            {
+                out.push_back(static_cast<uint8_t>(size + 1));
+                out.push_back(type);
+                out.insert(out.end(), data, data + size);
+            }
+
+            // Longest prefix of name within size bytes that does not split a UTF-8 sequence
+            inline size_t Utf8Prefix(const std::string &name, size_t size)
+            {
+                if (size >= name.size())
+                    return name.size();
+                while (size > 0 && (static_cast<uint8_t>(name[size]) & 0xC0) == 0x80)
+                    --size;
+                return size;
+            }
+        } // namespace detail
+
+        // Bytes every field takes encoded in full, the local name complete and uuids in their shortest form
+        inline size_t EncodedSize(const Fields &fields)
+        {
+            size_t size = 0;
+            if (fields.flags.has_value())
+                size += SectionSize(1);
+            if (fields.manufacturerId.has_value())
+                size += SectionSize(2 + fields.manufacturerData.size());
+
+            size_t shortUuids = 0;
+            size_t longUuids = 0;
+            for (const auto &uuid : fields.serviceUuids)
+                IsShortUuid(uuid) ? ++shortUuids : ++longUuids;
+            if (shortUuids > 0)
+                size += SectionSize(shortUuids * 2);
+            if (longUuids > 0)
+                size += SectionSize(longUuids * 16);
+
+            for (const auto &serviceData : fields.serviceData)
+                size += SectionSize((IsShortUuid(serviceData.uuid) ? 2 : 16) + serviceData.data.size());
+            if (fields.localName.has_value())
+                size += SectionSize(fields.localName->size());
+            return size;
+        }
+
+        /// Encodes fields by priority within budget bytes: flags, manufacturer data, service uuids,
+        /// service data, then the local name, shortened to the bytes left if needed.
+        /// Uuid lists keep what fits and are marked incomplete, other fields are left out whole
+        inline Encoded Encode(const Fields &fields, size_t budget)
+        {
+            Encoded encoded;
+            std::vector<uint8_t> &out = encoded.payload;
+            auto left = [&]()
+            { return budget > out.size() ? budget - out.size() : 0; };
+
+            if (fields.flags.has_value())
+            {
+                if (left() >= SectionSize(1))
+                    detail::AppendSection(out, kFlags, &fields.flags.value(), 1);
+                else
+                    encoded.truncated.push_back(Field::Flags);
+            }
+
+            if (fields.manufacturerId.has_value())
+            {
+                if (left() >= SectionSize(2 + fields.manufacturerData.size()) && fields.manufacturerData.size() <= 252)
+                {
+                    std::vector<uint8_t> data{static_cast<uint8_t>(*fields.manufacturerId), static_cast<uint8_t>(*fields.manufacturerId >> 8)};
+                    data.insert(data.end(), fields.manufacturerData.begin(), fields.manufacturerData.end());
+                    detail::AppendSection(out, kManufacturerData, data.data(), data.size());
+                }
+                else
+                {
+                    encoded.truncated.push_back(Field::ManufacturerData);
+                }
+            }
+
+            // 16 bit uuids first, they fit eight times more often
+            bool uuidsTruncated = false;
+            for (bool shortForm : {true, false})
+            {
+                size_t uuidSize = shortForm ? 2 : 16;
+                std::vector<uint8_t> data;
+                size_t count = 0;
+                for (const auto &uuid : fields.serviceUuids)
+                {
+                    if (IsShortUuid(uuid) != shortForm)
+                        continue;
+                    ++count;
+                    if (left() >= SectionSize(data.size() + uuidSize) && data.size() + uuidSize <= 254)
+                        detail::AppendUuid(data, uuid);
+                    else
+                        uuidsTruncated = true;
+                }
+                if (data.empty())
+                    continue;
+                bool complete = data.size() / uuidSize == count;
+                uint8_t type = shortForm ? (complete ? kCompleteServiceUuids16 : kIncompleteServiceUuids16)
+                                         : (complete ? kCompleteServiceUuids128 : kIncompleteServiceUuids128);
+                detail::AppendSection(out, type, data.data(), data.size());
+            }
+            if (uuidsTruncated)
+                encoded.truncated.push_back(Field::ServiceUuids);
+
+            bool serviceDataTruncated = false;
+            for (const auto &serviceData : fields.serviceData)
+            {
+                bool shortForm = IsShortUuid(serviceData.uuid);
+                std::vector<uint8_t> data;
+                detail::AppendUuid(data, serviceData.uuid);
+                data.insert(data.end(), serviceData.data.begin(), serviceData.data.end());
+                if (left() >= SectionSize(data.size()) && data.size() <= 254)
+                    detail::AppendSection(out, shortForm ? kServiceData16 : kServiceData128, data.data(), data.size());
+                else
+                    serviceDataTruncated = true;
+            }
+            if (serviceDataTruncated)
+                encoded.truncated.push_back(Field::ServiceData);
+
+            if (fields.localName.has_value())
+            {
+                const std::string &name = *fields.localName;
+                size_t room = left() > SectionSize(0) ? left() - SectionSize(0) : 0;
+                size_t length = detail::Utf8Prefix(name, room < 254 ? room : 254);
+                if (length == name.size())
+                {
+                    detail::AppendSection(out, kCompleteLocalName, reinterpret_cast<const uint8_t *>(name.data()), length);
+                }
+                else
+                {
+                    if (length > 0)
+                        detail::AppendSection(out, kShortenedLocalName, reinterpret_cast<const uint8_t *>(name.data()), length);
+                    encoded.truncated.push_back(Field::LocalName);
+                }
+            }
+            return encoded;
+        }
+
+        // Returns nullopt if a structure runs past the end of the payload, unknown types are skipped
+        inline std::optional<Fields> Decode(const uint8_t *payload, size_t size)
+        {
+            Fields fields;
+            size_t position = 0;
+            while (position < size)
+            {
+                size_t length = payload[position];
+                // Zero length marks the padding of the significant part
+                if (length == 0)
+                    break;
+                if (length > size - position - 1)
+                    return std::nullopt;
+
+                uint8_t type = payload[position + 1];
+                const uint8_t *data = payload + position + 2;
+                size_t dataSize = length - 1;
+                position += 1 + length;
+
+                switch (type)
+                {
+                case kFlags:
+                    if (dataSize >= 1)
+                        fields.flags = data[0];
+                    break;
+                case kIncompleteServiceUuids16:
+                case kCompleteServiceUuids16:
+                case kIncompleteServiceUuids32:
+                case kCompleteServiceUuids32:
+                case kIncompleteServiceUuids128:
+                case kCompleteServiceUuids128:
+                {
+                    size_t uuidSize = 16;
+                    if (type <= kCompleteServiceUuids16)
+                        uuidSize = 2;
+                    else if (type <= kCompleteServiceUuids32)
+                        uuidSize = 4;
+                    for (size_t i = 0; i + uuidSize <= dataSize; i += uuidSize)
+                        fields.serviceUuids.push_back(detail::ReadUuid(data + i, uuidSize));
+                    if (type == kIncompleteServiceUuids16 || type == kIncompleteServiceUuids32 || type == kIncompleteServiceUuids128)
+                        fields.serviceUuidsComplete = false;
+                    break;
+                }
+                case kShortenedLocalName:
+                case kCompleteLocalName:
+                    fields.localName = std::string(reinterpret_cast<const char *>(data), dataSize);
+                    fields.localNameComplete = type == kCompleteLocalName;
+                    break;
+                case kServiceData16:
+                case kServiceData128:
+                {
+                    size_t uuidSize = type == kServiceData16 ? 2 : 16;
+                    if (dataSize < uuidSize)
+                        break;
+                    fields.serviceData.push_back(ServiceData{detail::ReadUuid(data, uuidSize),
+                                                             std::vector<uint8_t>(data + uuidSize, data + dataSize)});
+                    break;
+                }
+                case kManufacturerData:
+                    if (dataSize < 2)
+                        break;
+                    fields.manufacturerId = static_cast<uint16_t>(data[0] | data[1] << 8);
+                    fields.manufacturerData.assign(data + 2, data + dataSize);
+                    break;
+                default:
+                    break;
+                }
+            }
+            return fields;
+        }
+
+    } // namespace ad
+
+} // namespace ble_peripheral
@@ -0,0 +1,81 @@
+#include "advertising_status_tracker.h"
+
+namespace ble_peripheral
+{
+
+  const void *AdvertisingStatusTracker::Key(Provider const &provider)
+  {
+    return winrt::get_abi(provider.as<winrt::Windows::Foundation::IUnknown>());
+  }
+
+  bool AdvertisingStatusTracker::CountsAsStarted(Status status)
+  {
+    return status == Status::Started;
+  }
+
+  void AdvertisingStatusTracker::Track(Provider const &provider, Status status)
+  {
+    const void *key = Key(provider);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = statuses_.try_emplace(key, status);
+    if (!inserted)
+    {
+      started_ -= CountsAsStarted(it->second) ? 1 : 0;
+      it->second = status;
+    }
+    started_ += CountsAsStarted(status) ? 1 : 0;
+    allStarted_ = AllStartedLocked();
+  }
+
+  std::optional<AdvertisingStatusTracker::Status> AdvertisingStatusTracker::Untrack(Provider const &provider)
+  {
+    const void *key = Key(provider);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = statuses_.find(key);
+    if (it == statuses_.end())
+      return std::nullopt;
+    Status status = it->second;
+    started_ -= CountsAsStarted(status) ? 1 : 0;
+    statuses_.erase(it);
+    allStarted_ = AllStartedLocked();
+    return status;
+  }
+
+  AdvertisingStatusTracker::Transition AdvertisingStatusTracker::Update(Provider const &provider, Status status)
+  {
+    const void *key = Key(provider);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = statuses_.find(key);
+    if (it == statuses_.end())
+      return Transition::None;
+    started_ -= CountsAsStarted(it->second) ? 1 : 0;
+    started_ += CountsAsStarted(status) ? 1 : 0;
+    it->second = status;
+
+    bool allStarted = AllStartedLocked();
+    if (allStarted == allStarted_)
+      return Transition::None;
+    allStarted_ = allStarted;
+    return allStarted ? Transition::AllStarted : Transition::NoLongerAllStarted;
+  }
+
+  bool AdvertisingStatusTracker::IsStarted(Provider const &provider) const
+  {
+    const void *key = Key(provider);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = statuses_.find(key);
+    return it != statuses_.end() && CountsAsStarted(it->second);
+  }
+
+  bool AdvertisingStatusTracker::AllStarted() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allStarted_;
+  }
+
+  bool AdvertisingStatusTracker::AllStartedLocked() const
+  {
+    return !statuses_.empty() && started_ == statuses_.size();
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <winrt/Windows.Devices.Bluetooth.GenericAttributeProfile.h>
+
+namespace ble_peripheral
+{
+
+    /// Advertisement status of every service provider, cached from AdvertisementStatusChanged
+    /// so nothing has to ask the providers across the ABI. Providers are keyed by their ABI pointer,
+    /// a replaced service is a new provider and cannot be confused with the one it replaces.
+    /// Keeps a count of started providers, so whether all services advertise is answered in O(1)
+    class AdvertisingStatusTracker
+    {
+    public:
+        using Provider = winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattServiceProvider;
+        using Status = winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattServiceProviderAdvertisementStatus;
+
+        // Change of whether all tracked providers are started
+        enum class Transition
+        {
+            None,
+            AllStarted,
+            NoLongerAllStarted,
+        };
+
+        AdvertisingStatusTracker() = default;
+
+        AdvertisingStatusTracker(const AdvertisingStatusTracker &) = delete;
+        AdvertisingStatusTracker &operator=(const AdvertisingStatusTracker &) = delete;
+
+        // Adding and removing providers moves the aggregate without reporting a transition,
+        // only status events do
+        void Track(Provider const &provider, Status status);
+        // Returns the last status of provider, nullopt if it was not tracked
+        std::optional<Status> Untrack(Provider const &provider);
+        // Events of untracked providers, e.g. raised while their service is removed, are ignored
+        Transition Update(Provider const &provider, Status status);
+
+        bool IsStarted(Provider const &provider) const;
+        // False without providers, like IsAdvertising always was
+        bool AllStarted() const;
+
+    private:
+        // The IUnknown pointer, the only one COM guarantees to be the same for every reference to an object
+        static const void *Key(Provider const &provider);
+        static bool CountsAsStarted(Status status);
+        bool AllStartedLocked() const;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<const void *, Status> statuses_;
+        size_t started_ = 0;
+        bool allStarted_ = false;
+    };
+
+} // namespace ble_peripheral
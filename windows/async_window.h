@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+#include <winrt/Windows.Foundation.h>
+
+namespace ble_peripheral
+{
+
+    /// Keeps at most limit WinRT async operations outstanding.
+    /// Operations are started in the order they are pushed and awaited oldest first,
+    /// so their latency overlaps while the order they were issued in stays deterministic
+    template <typename TResult>
+    class AsyncWindow
+    {
+    public:
+        using Operation = winrt::Windows::Foundation::IAsyncOperation<TResult>;
+
+        explicit AsyncWindow(size_t limit) : limit_(limit == 0 ? 1 : limit) {}
+
+        bool full() const { return pending_.size() >= limit_; }
+        bool empty() const { return pending_.empty(); }
+
+        void Push(size_t index, Operation operation)
+        {
+            pending_.emplace_back(index, std::move(operation));
+        }
+
+        // Removes the oldest operation, returns it along with the index it was pushed with
+        std::pair<size_t, Operation> PopOldest()
+        {
+            auto oldest = std::move(pending_.front());
+            pending_.pop_front();
+            return oldest;
+        }
+
+    private:
+        size_t limit_;
+        std::deque<std::pair<size_t, Operation>> pending_;
+    };
+
+} // namespace ble_peripheral
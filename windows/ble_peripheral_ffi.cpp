@@ -0,0 +1,110 @@
+#include "include/ble_peripheral/ble_peripheral_ffi.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "ble_peripheral_plugin.h"
+#include "logger.h"
+#include "write_ring.h"
+
+namespace {
+
+// Consumer reference, only touched by the isolate that started the ring
+std::shared_ptr<ble_peripheral::WriteRing> writeRing;
+
+}  // namespace
+
+uint8_t* BlePeripheralAllocBuffer(size_t size) {
+  return static_cast<uint8_t*>(std::malloc(size == 0 ? 1 : size));
+}
+
+void BlePeripheralFreeBuffer(uint8_t* buffer) {
+  std::free(buffer);
+}
+
+int32_t BlePeripheralNotifyValue(
+    const char* characteristic_id, size_t characteristic_id_length,
+    const char* device_id, size_t device_id_length,
+    const uint8_t* value, size_t value_length) {
+  using ble_peripheral::BlePeripheralPlugin;
+
+  BlePeripheralPlugin* plugin = BlePeripheralPlugin::Instance();
+  if (plugin == nullptr)
+    return BLE_PERIPHERAL_FFI_NOT_REGISTERED;
+
+  try {
+    std::string characteristicId(characteristic_id, characteristic_id_length);
+    std::string deviceId;
+    if (device_id != nullptr)
+      deviceId.assign(device_id, device_id_length);
+
+    switch (plugin->NotifyValue(characteristicId, value, value_length,
+                                device_id == nullptr ? nullptr : &deviceId)) {
+      case BlePeripheralPlugin::NotifyResult::Sent:
+        return BLE_PERIPHERAL_FFI_OK;
+      case BlePeripheralPlugin::NotifyResult::CharacteristicNotFound:
+        return BLE_PERIPHERAL_FFI_CHARACTERISTIC_NOT_FOUND;
+      case BlePeripheralPlugin::NotifyResult::DeviceNotSubscribed:
+        return BLE_PERIPHERAL_FFI_DEVICE_NOT_SUBSCRIBED;
+      case BlePeripheralPlugin::NotifyResult::ValueExceedsMtu:
+        return BLE_PERIPHERAL_FFI_VALUE_EXCEEDS_MTU;
+    }
+  } catch (const winrt::hresult_error& e) {
+    BLE_LOG_ERROR("BlePeripheralNotifyValue failed: ", e.message());
+  } catch (const std::exception& e) {
+    BLE_LOG_ERROR("BlePeripheralNotifyValue failed: ", e.what());
+  }
+  return BLE_PERIPHERAL_FFI_ERROR;
+}
+
+int32_t BlePeripheralWriteRingStart(size_t capacity, void* post_c_object,
+                                    int64_t port) {
+  using ble_peripheral::BlePeripheralPlugin;
+  using ble_peripheral::WriteRing;
+
+  BlePeripheralPlugin* plugin = BlePeripheralPlugin::Instance();
+  if (plugin == nullptr)
+    return BLE_PERIPHERAL_FFI_NOT_REGISTERED;
+  if (post_c_object == nullptr)
+    return BLE_PERIPHERAL_FFI_ERROR;
+
+  try {
+    writeRing = std::make_shared<WriteRing>(
+        capacity,
+        reinterpret_cast<ble_peripheral::DartPostCObjectFunction>(post_c_object),
+        port);
+  } catch (const std::bad_alloc&) {
+    BLE_LOG_ERROR("BlePeripheralWriteRingStart failed: cannot allocate ", capacity, " bytes");
+    return BLE_PERIPHERAL_FFI_ERROR;
+  }
+  plugin->StartWriteRing(writeRing);
+  return BLE_PERIPHERAL_FFI_OK;
+}
+
+void BlePeripheralWriteRingStop(void) {
+  using ble_peripheral::BlePeripheralPlugin;
+
+  BlePeripheralPlugin* plugin = BlePeripheralPlugin::Instance();
+  if (plugin != nullptr)
+    plugin->StopWriteRing();
+  writeRing.reset();
+}
+
+void BlePeripheralWriteRingRearm(void) {
+  if (writeRing != nullptr)
+    writeRing->Rearm();
+}
+
+size_t BlePeripheralWriteRingReadable(void) {
+  return writeRing == nullptr ? 0 : writeRing->Readable();
+}
+
+const uint8_t* BlePeripheralWriteRingReadPointer(void) {
+  return writeRing == nullptr ? nullptr : writeRing->ReadPointer();
+}
+
+void BlePeripheralWriteRingRelease(size_t length) {
+  if (writeRing != nullptr)
+    writeRing->Release(length);
+}
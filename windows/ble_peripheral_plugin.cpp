@@ -2,12 +2,17 @@
 #include <windows.h>
 #include <flutter/plugin_registrar_windows.h>
 #include <map>
+#include <set>
 #include <memory>
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
 #include <thread>
 #include <regex>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include "Utils.h"
 
 #include "BlePeripheral.g.h"
@@ -17,22 +22,119 @@ namespace ble_peripheral
   using ble_peripheral::BleCallback;
   using ble_peripheral::BlePeripheralChannel;
   using ble_peripheral::ErrorOr;
-  std::unique_ptr<BleCallback> bleCallback;
-  std::map<std::string, GattServiceProviderObject *> serviceProviderMap;
-  std::mutex cout_mutex;
+  std::unique_ptr<BleCallbackDispatcher> bleCallback;
 
   // static
   void BlePeripheralPlugin::RegisterWithRegistrar(flutter::PluginRegistrarWindows *registrar)
   {
     auto plugin = std::make_unique<BlePeripheralPlugin>(registrar);
     BlePeripheralChannel::SetUp(registrar->messenger(), plugin.get());
-    bleCallback = std::make_unique<BleCallback>(registrar->messenger());
+    bleCallback = std::make_unique<BleCallbackDispatcher>(registrar->messenger());
+    // updateCharacteristic in the fixed layout of hot_message_codec.h, bypassing BlePeripheralChannel
+    registrar->messenger()->SetMessageHandler(
+        hot_message::kUpdateCharacteristicChannel,
+        [](const uint8_t *message, size_t message_size, flutter::BinaryReply reply)
+        {
+          std::vector<uint8_t> encoded;
+          hot_message::ValueUpdateView update;
+          BlePeripheralPlugin *plugin = Instance();
+          if (plugin == nullptr)
+          {
+            std::string error = "Plugin is not registered";
+            encoded = hot_message::EncodeValueUpdateReply(&error);
+          }
+          else if (!hot_message::DecodeValueUpdate(message, message_size, update))
+          {
+            std::string error = "Malformed updateCharacteristic message";
+            encoded = hot_message::EncodeValueUpdateReply(&error);
+          }
+          else
+          {
+            const std::string *deviceId = update.deviceId.has_value() ? &update.deviceId.value() : nullptr;
+            std::optional<FlutterError> error = plugin->NotifyError(
+                plugin->NotifyValue(update.characteristicId, update.value, update.valueLength, deviceId), deviceId);
+            encoded = hot_message::EncodeValueUpdateReply(error.has_value() ? &error->message() : nullptr);
+          }
+          reply(encoded.data(), encoded.size());
+        });
+    registrar->messenger()->SetMessageHandler(
+        hot_message::kReadRequestCallbackChannel,
+        [](const uint8_t *message, size_t message_size, flutter::BinaryReply reply)
+        {
+          BlePeripheralPlugin *plugin = Instance();
+          if (plugin != nullptr && message_size > 0)
+            plugin->readRequestCallback_.store(message[0] != 0);
+          reply(nullptr, 0);
+        });
     registrar->AddPlugin(std::move(plugin));
   }
 
-  BlePeripheralPlugin::BlePeripheralPlugin(flutter::PluginRegistrarWindows *registrar) : uiThreadHandler_(registrar) {}
+  std::atomic<BlePeripheralPlugin *> BlePeripheralPlugin::instance_{nullptr};
 
-  BlePeripheralPlugin::~BlePeripheralPlugin() {}
+  BlePeripheralPlugin::BlePeripheralPlugin(flutter::PluginRegistrarWindows *registrar) : uiThreadHandler_(registrar)
+  {
+    SessionRegistry::Callbacks sessionCallbacks;
+    sessionCallbacks.onConnectionStateChange = [this](const std::string &deviceId, bool connected)
+    {
+      if (!connected)
+      {
+        // The cached name is refreshed when the device connects again
+        deviceNames_.Invalidate(deviceId);
+        preparedWrites_.ClearSession(deviceId);
+      }
+      uiThreadHandler_.Post([deviceId, connected]
+                            { bleCallback->OnConnectionStateChange(deviceId, connected, SuccessCallback, ErrorCallback); });
+    };
+    sessionCallbacks.onMtuChange = [this](const std::string &deviceId, uint16_t maxPduSize)
+    {
+      int64_t mtu = maxPduSize;
+      uiThreadHandler_.Post([deviceId, mtu]
+                            { bleCallback->OnMtuChange(deviceId, mtu, SuccessCallback, ErrorCallback); });
+    };
+    sessions_ = std::make_unique<SessionRegistry>(std::move(sessionCallbacks));
+    advertisementPublisher_ = std::make_shared<AdvertisementPublisher>(
+        [this](BluetoothError error)
+        {
+          std::string errorStr = ParseBluetoothError(error);
+          BLE_LOG_ERROR("Advertisement publisher aborted, Error ", errorStr);
+          uiThreadHandler_.Post([errorStr]
+                                { bleCallback->OnAdvertisingStatusUpdate(false, &errorStr, SuccessCallback, ErrorCallback); });
+        });
+    instance_ = this;
+  }
+
+  BlePeripheralPlugin::~BlePeripheralPlugin()
+  {
+    BlePeripheralPlugin *self = this;
+    instance_.compare_exchange_strong(self, nullptr);
+    // Handlers of the services point to this plugin
+    ClearServices();
+    Logger::Instance().Flush();
+  }
+
+  GattCharacteristicObject::GattCharacteristicObject()
+  {
+    GattObjectStats::characteristics++;
+    GattObjectStats::bytes += sizeof(GattCharacteristicObject);
+  }
+
+  GattCharacteristicObject::~GattCharacteristicObject()
+  {
+    GattObjectStats::characteristics--;
+    GattObjectStats::bytes -= sizeof(GattCharacteristicObject);
+  }
+
+  GattServiceProviderObject::GattServiceProviderObject()
+  {
+    GattObjectStats::services++;
+    GattObjectStats::bytes += sizeof(GattServiceProviderObject);
+  }
+
+  GattServiceProviderObject::~GattServiceProviderObject()
+  {
+    GattObjectStats::services--;
+    GattObjectStats::bytes -= sizeof(GattServiceProviderObject);
+  }
 
   winrt::fire_and_forget BlePeripheralPlugin::InitializeAdapter()
   {
@@ -52,7 +154,19 @@ namespace ble_peripheral
     }
     if (!bluetoothRadio)
     {
-      std::cout << "Bluetooth is not available" << std::endl;
+      BLE_LOG_ERROR("Bluetooth is not available");
+      co_return;
+    }
+
+    try
+    {
+      BluetoothAdapter adapter = co_await BluetoothAdapter::GetDefaultAsync();
+      if (adapter != nullptr)
+        extendedAdvertisingSupported_ = adapter.IsExtendedAdvertisingSupported();
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      BLE_LOG_WARNING("Extended advertising support unknown: ", e.message());
     }
   }
 
@@ -64,11 +178,8 @@ namespace ble_peripheral
 
   ErrorOr<std::optional<bool>> BlePeripheralPlugin::IsAdvertising()
   {
-    // Check is any service is advertising, or if services list is empty
-    // Get serviceProviderMap length
-    if (serviceProviderMap.size() == 0)
-      return ErrorOr<std::optional<bool>>(std::optional<bool>(false));
-    bool advertising = AreAllServicesStarted();
+    // False if services list is empty
+    bool advertising = advertisingStatus_.AllStarted();
     return ErrorOr<std::optional<bool>>(std::optional<bool>(advertising));
   };
 
@@ -93,165 +204,888 @@ namespace ble_peripheral
   {
     // lower case the service_id
     std::string serviceId = to_lower_case(service_id);
-    if (serviceProviderMap.find(serviceId) == serviceProviderMap.end())
+    auto gattServiceObject = serviceRegistry_.Remove(serviceId);
+    if (gattServiceObject == nullptr)
     {
-      std::cout << "Service not found in map" << std::endl;
+      BLE_LOG_WARNING("Service not found in map");
       return FlutterError("Service not found");
     }
-    auto gattServiceObject = serviceProviderMap[serviceId];
-    disposeGattServiceObject(gattServiceObject);
-    serviceProviderMap.erase(serviceId);
+    disposeGattServiceObject(gattServiceObject.get());
     return std::nullopt;
   }
 
   std::optional<FlutterError> BlePeripheralPlugin::ClearServices()
   {
-    for (auto const &[key, gattServiceObject] : serviceProviderMap)
+    for (auto const &gattServiceObject : serviceRegistry_.Clear())
     {
-      disposeGattServiceObject(gattServiceObject);
+      disposeGattServiceObject(gattServiceObject.get());
     }
-    // Clear map
-    serviceProviderMap.clear();
     return std::nullopt;
   }
 
   ErrorOr<flutter::EncodableList> BlePeripheralPlugin::GetServices()
   {
     flutter::EncodableList services = flutter::EncodableList();
-    for (auto const &[key, gattServiceObject] : serviceProviderMap)
+    for (auto const &[key, gattServiceObject] : serviceRegistry_.snapshot()->services)
     {
       services.push_back(flutter::EncodableValue(key));
     }
     return services;
   }
 
-  std::optional<FlutterError> BlePeripheralPlugin::StartAdvertising(
+  void BlePeripheralPlugin::StartAdvertising(
       const flutter::EncodableList &services,
       const std::string *local_name,
       const int64_t *timeout,
       const ManufacturerData *manufacturer_data,
-      bool add_manufacturer_data_in_scan_response)
+      bool add_manufacturer_data_in_scan_response,
+      std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
   {
+    // Arguments are checked here, everything calling into the providers runs off the platform thread
+    if (serviceRegistry_.snapshot()->services.empty())
+    {
+      result(FlutterError("No services added to advertise"));
+      return;
+    }
+
+    AdvertisementPublisher::Config publisherConfig;
     try
     {
-      // check if services are empty
-      if (serviceProviderMap.size() == 0)
-        return FlutterError("No services added to advertise");
+      for (const auto &service : services)
+        publisherConfig.serviceUuids.push_back(uuid_to_guid(std::get<std::string>(service)));
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      result(FlutterError(winrt::to_string(e.message())));
+      return;
+    }
+    if (local_name != nullptr && !local_name->empty())
+      publisherConfig.localName = *local_name;
+    if (manufacturer_data != nullptr)
+    {
+      if (manufacturer_data->manufacturer_id() < 0 || manufacturer_data->manufacturer_id() > 0xFFFF)
+      {
+        result(FlutterError("Manufacturer id must fit in 16 bits"));
+        return;
+      }
+      publisherConfig.manufacturerId = static_cast<uint16_t>(manufacturer_data->manufacturer_id());
+      publisherConfig.manufacturerData = manufacturer_data->data();
+    }
+    if (add_manufacturer_data_in_scan_response)
+      BLE_LOG_WARNING("Windows chooses the scan response, manufacturer data is advertised instead");
+    if (auto publisherError = AdvertisementPublisher::Validate(publisherConfig, extendedAdvertisingSupported_))
+    {
+      result(FlutterError(*publisherError));
+      return;
+    }
 
-      if (AreAllServicesStarted())
+    std::optional<int64_t> timeoutMs;
+    if (timeout != nullptr && *timeout > 0)
+      timeoutMs = *timeout;
+    StartAdvertisingAsync(std::move(publisherConfig), timeoutMs, std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::StartAdvertisingAsync(AdvertisementPublisher::Config publisherConfig,
+                                                                    std::optional<int64_t> timeoutMs,
+                                                                    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    co_await winrt::resume_background();
+    StopAdvertisementScheduler();
+
+    std::lock_guard<std::mutex> lock(advertisingMutex_);
+    flutter::EncodableMap failedServices;
+    try
+    {
+      if (auto publisherError = advertisementPublisher_->Start(publisherConfig, extendedAdvertisingSupported_))
       {
-        std::cout << "All services already advertising" << std::endl;
+        uiThreadHandler_.Post([result, error = *publisherError]
+                              { result(FlutterError(error)); });
+        co_return;
+      }
+
+      auto registered = serviceRegistry_.snapshot();
+      if (advertisingStatus_.AllStarted())
+      {
+        BLE_LOG_INFO("All services already advertising");
         uiThreadHandler_.Post([]
                               { bleCallback->OnAdvertisingStatusUpdate(true, nullptr, SuccessCallback, ErrorCallback); });
-        return std::nullopt;
       }
+      else
+      {
+        auto advertisementParameter = GattServiceProviderAdvertisingParameters();
+        advertisementParameter.IsDiscoverable(true);
+        advertisementParameter.IsConnectable(true);
 
-      auto advertisementParameter = GattServiceProviderAdvertisingParameters();
-      advertisementParameter.IsDiscoverable(true);
-      advertisementParameter.IsConnectable(true);
+        // Started as one transaction, if any service fails the ones started here are stopped again
+        std::vector<std::shared_ptr<GattServiceProviderObject>> started;
+        for (auto const &[key, gattServiceObject] : registered->services)
+        {
+          if (advertisingStatus_.IsStarted(gattServiceObject->obj))
+          {
+            BLE_LOG_DEBUG("Service ", key, " is already advertising, skipping");
+            continue;
+          }
+          try
+          {
+            gattServiceObject->obj.StartAdvertising(advertisementParameter);
+            started.push_back(gattServiceObject);
+          }
+          catch (const winrt::hresult_error &e)
+          {
+            failedServices.insert_or_assign(EncodableValue(key), EncodableValue(winrt::to_string(e.message())));
+          }
+        }
 
-      for (auto const &[key, gattServiceObject] : serviceProviderMap)
-      {
-        if (gattServiceObject->obj.AdvertisementStatus() == GattServiceProviderAdvertisementStatus::Started)
+        if (!failedServices.empty())
         {
-          std::cout << "Service " << key << " is already advertising, skipping" << std::endl;
-          continue;
+          BLE_LOG_WARNING(failedServices.size(), " of ", registered->services.size(), " services failed to advertise, rolling back");
+          for (const auto &gattServiceObject : started)
+          {
+            try
+            {
+              gattServiceObject->obj.StopAdvertising();
+            }
+            catch (const winrt::hresult_error &e)
+            {
+              BLE_LOG_ERROR("Failed to roll back advertising, Error: ", e.message());
+            }
+          }
+          advertisementPublisher_->Stop();
         }
-        gattServiceObject->obj.StartAdvertising(advertisementParameter);
       }
 
-      return std::nullopt;
+      // Stops the services and the publisher alike, like the advertising timeout of Android
+      if (failedServices.empty() && timeoutMs.has_value())
+      {
+        advertisementPublisher_->ArmTimeout(std::chrono::milliseconds(*timeoutMs), [this]
+                                            { StopAdvertisingServices(); });
+      }
     }
-    catch (...)
+    catch (const winrt::hresult_error &e)
     {
-      std::cout << "Error: "
-                << "Unknown error" << std::endl;
-      return std::nullopt;
+      BLE_LOG_ERROR("Failed to start advertising: ", e.message());
+      uiThreadHandler_.Post([result, error = winrt::to_string(e.message())]
+                            { result(FlutterError(error)); });
+      co_return;
+    }
+
+    // Any failed service rolled the transaction back, nothing is advertising
+    if (!failedServices.empty())
+    {
+      uiThreadHandler_.Post([result, failedServices]
+                            { result(FlutterError("Advertising rolled back",
+                                                  std::to_string(failedServices.size()) + " services failed to start",
+                                                  EncodableValue(failedServices))); });
+      co_return;
     }
+    uiThreadHandler_.Post([result, failedServices]
+                          { result(failedServices); });
   }
 
-  std::optional<FlutterError> BlePeripheralPlugin::StopAdvertising()
+  void BlePeripheralPlugin::StopAdvertising(std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
   {
-    for (auto const &[key, gattServiceObject] : serviceProviderMap)
+    StopAdvertisingAsync(std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::StopAdvertisingAsync(std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    co_await winrt::resume_background();
+    flutter::EncodableMap failedServices = StopAdvertisingServices();
+    uiThreadHandler_.Post([result, failedServices]
+                          { result(failedServices); });
+  }
+
+  flutter::EncodableMap BlePeripheralPlugin::StopAdvertisingServices()
+  {
+    std::lock_guard<std::mutex> lock(advertisingMutex_);
+    // When all services advertised, their Stopped events report the transition
+    bool reportedByEvents = advertisingStatus_.AllStarted();
+    advertisementPublisher_->Stop();
+    flutter::EncodableMap failedServices;
+    for (auto const &[key, gattServiceObject] : serviceRegistry_.snapshot()->services)
     {
       try
       {
         gattServiceObject->obj.StopAdvertising();
-        std::cout << "Stopped advertising for service: " << key << std::endl;
+        BLE_LOG_DEBUG("Stopped advertising for service: ", key);
       }
       catch (const winrt::hresult_error &e)
       {
-        std::wcerr << "Failed to stop service: " << key.c_str() << ", Error: " << e.message().c_str() << std::endl;
+        BLE_LOG_ERROR("Failed to stop service: ", key, ", Error: ", e.message());
+        failedServices.insert_or_assign(EncodableValue(key), EncodableValue(winrt::to_string(e.message())));
       }
-      catch (...)
+    }
+    if (!reportedByEvents)
+    {
+      uiThreadHandler_.Post([]
+                            { bleCallback->OnAdvertisingStatusUpdate(false, nullptr, SuccessCallback, ErrorCallback); });
+    }
+    return failedServices;
+  }
+
+  void BlePeripheralPlugin::StartAdvertisementRotation(const flutter::EncodableList &sets,
+                                                       std::function<void(std::optional<FlutterError> reply)> result)
+  {
+    std::vector<AdvertisementScheduler::Set> schedulerSets;
+    bool anyConnectable = false;
+    try
+    {
+      for (const auto &value : sets)
       {
-        std::cout << "Error: Unknown error" << std::endl;
+        const auto &set = std::any_cast<const AdvertisementSet &>(std::get<CustomEncodableValue>(value));
+        AdvertisementScheduler::Set schedulerSet;
+        schedulerSet.id = set.id();
+        for (const auto &service : set.services())
+          schedulerSet.config.serviceUuids.push_back(uuid_to_guid(std::get<std::string>(service)));
+        if (set.local_name() != nullptr && !set.local_name()->empty())
+          schedulerSet.config.localName = *set.local_name();
+        if (const ManufacturerData *manufacturerData = set.manufacturer_data())
+        {
+          if (manufacturerData->manufacturer_id() < 0 || manufacturerData->manufacturer_id() > 0xFFFF)
+          {
+            result(FlutterError("Manufacturer id of advertisement set " + set.id() + " must fit in 16 bits"));
+            return;
+          }
+          schedulerSet.config.manufacturerId = static_cast<uint16_t>(manufacturerData->manufacturer_id());
+          schedulerSet.config.manufacturerData = manufacturerData->data();
+        }
+        schedulerSet.connectable = set.connectable();
+        schedulerSet.dwell = std::chrono::milliseconds(set.dwell_ms());
+        schedulerSet.priority = set.priority();
+        anyConnectable = anyConnectable || set.connectable();
+        schedulerSets.push_back(std::move(schedulerSet));
       }
     }
-    uiThreadHandler_.Post([]
-                          { bleCallback->OnAdvertisingStatusUpdate(false, nullptr, SuccessCallback, ErrorCallback); });
+    catch (const winrt::hresult_error &e)
+    {
+      result(FlutterError(winrt::to_string(e.message())));
+      return;
+    }
+    if (anyConnectable && serviceRegistry_.snapshot()->services.empty())
+    {
+      result(FlutterError("No services added to advertise in connectable sets"));
+      return;
+    }
+    StartAdvertisementRotationAsync(std::move(schedulerSets), std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::StartAdvertisementRotationAsync(std::vector<AdvertisementScheduler::Set> sets,
+                                                                              std::function<void(std::optional<FlutterError> reply)> result)
+  {
+    co_await winrt::resume_background();
+
+    // The rotation owns the radio, plain advertising would be on air in every slot
+    StopAdvertisementScheduler();
+    StopAdvertisingServices();
+    size_t setCount = sets.size();
+    std::shared_ptr<AdvertisementScheduler> scheduler;
+    std::optional<std::string> error;
+    try
+    {
+      scheduler = std::make_shared<AdvertisementScheduler>(
+          std::move(sets), extendedAdvertisingSupported_,
+          [this](bool advertise)
+          { SetServicesAdvertising(advertise); });
+      error = scheduler->Start();
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      error = winrt::to_string(e.message());
+    }
+    if (error.has_value())
+    {
+      uiThreadHandler_.Post([result, error = *error]
+                            { result(FlutterError(error)); });
+      co_return;
+    }
+
+    // A rotation started meanwhile is replaced like any other
+    if (auto previous = std::atomic_exchange(&advertisementScheduler_, scheduler))
+      previous->Stop();
+    BLE_LOG_INFO("Advertisement rotation started with ", setCount, " sets");
+    uiThreadHandler_.Post([result]
+                          { result(std::nullopt); });
+  }
+
+  void BlePeripheralPlugin::StopAdvertisementRotation(std::function<void(std::optional<FlutterError> reply)> result)
+  {
+    StopAdvertisementRotationAsync(std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::StopAdvertisementRotationAsync(std::function<void(std::optional<FlutterError> reply)> result)
+  {
+    co_await winrt::resume_background();
+    StopAdvertisementScheduler();
+    uiThreadHandler_.Post([result]
+                          { result(std::nullopt); });
+  }
+
+  void BlePeripheralPlugin::StopAdvertisementScheduler()
+  {
+    if (auto scheduler = std::atomic_exchange(&advertisementScheduler_, std::shared_ptr<AdvertisementScheduler>()))
+      scheduler->Stop();
+  }
+
+  ErrorOr<flutter::EncodableList> BlePeripheralPlugin::GetAdvertisementRotationStats()
+  {
+    flutter::EncodableList stats;
+    auto scheduler = std::atomic_load(&advertisementScheduler_);
+    if (scheduler == nullptr)
+      return stats;
+    for (const auto &set : scheduler->Stats())
+    {
+      stats.push_back(CustomEncodableValue(AdvertisementSetStats(
+          set.id, set.slots, set.failures, set.airtime.count(), set.airtimeShare)));
+    }
+    return stats;
+  }
+
+  std::optional<FlutterError> BlePeripheralPlugin::UpdateAdvertisingData(
+      const std::string *local_name,
+      const ManufacturerData *manufacturer_data)
+  {
+    if (std::atomic_load(&advertisementScheduler_) != nullptr)
+      return FlutterError("Advertisement rotation is running, restart it with the new sets instead");
+
+    AdvertisementPublisher::Config publisherConfig;
+    if (local_name != nullptr && !local_name->empty())
+      publisherConfig.localName = *local_name;
+    if (manufacturer_data != nullptr)
+    {
+      if (manufacturer_data->manufacturer_id() < 0 || manufacturer_data->manufacturer_id() > 0xFFFF)
+        return FlutterError("Manufacturer id must fit in 16 bits");
+      publisherConfig.manufacturerId = static_cast<uint16_t>(manufacturer_data->manufacturer_id());
+      publisherConfig.manufacturerData = manufacturer_data->data();
+    }
+    // Only the publisher is swapped, the services keep advertising and raise no status changes
+    try
+    {
+      if (auto error = advertisementPublisher_->Update(std::move(publisherConfig)))
+        return FlutterError(*error);
+    }
+    catch (const winrt::hresult_error &e)
+    {
+      return FlutterError(winrt::to_string(e.message()));
+    }
     return std::nullopt;
   }
 
+  void BlePeripheralPlugin::SetServicesAdvertising(bool advertise)
+  {
+    std::lock_guard<std::mutex> lock(advertisingMutex_);
+    auto advertisementParameter = GattServiceProviderAdvertisingParameters();
+    advertisementParameter.IsDiscoverable(true);
+    advertisementParameter.IsConnectable(true);
+    for (auto const &[key, gattServiceObject] : serviceRegistry_.snapshot()->services)
+    {
+      try
+      {
+        if (advertise)
+          gattServiceObject->obj.StartAdvertising(advertisementParameter);
+        else
+          gattServiceObject->obj.StopAdvertising();
+      }
+      catch (const winrt::hresult_error &e)
+      {
+        BLE_LOG_ERROR("Failed to switch advertising of ", key, ", Error: ", e.message());
+      }
+    }
+  }
+
   std::optional<FlutterError> BlePeripheralPlugin::UpdateCharacteristic(
       const std::string &characteristic_id,
       const std::vector<uint8_t> &value,
       const std::string *device_id)
   {
-    GattCharacteristicObject *gattCharacteristicObject = FindGattCharacteristicObject(characteristic_id);
+    return NotifyError(NotifyValue(characteristic_id, value.data(), value.size(), device_id), device_id);
+  }
+
+  std::optional<FlutterError> BlePeripheralPlugin::NotifyError(NotifyResult result, const std::string *deviceId)
+  {
+    switch (result)
+    {
+    case NotifyResult::CharacteristicNotFound:
+      return FlutterError("Failed to get this characteristic");
+    case NotifyResult::DeviceNotSubscribed:
+      return FlutterError("Device is not subscribed to this characteristic");
+    case NotifyResult::ValueExceedsMtu:
+    {
+      // The session may have closed since NotifyValue looked up its MTU
+      std::optional<uint16_t> maxPduSize = deviceId != nullptr ? sessions_->MaxPduSize(*deviceId) : std::nullopt;
+      if (!maxPduSize.has_value())
+        return FlutterError("Value exceeds the MTU of this device");
+      return FlutterError("Value exceeds the MTU of this device, max " + std::to_string(*maxPduSize - 3) + " bytes");
+    }
+    default:
+      return std::nullopt;
+    }
+  }
+
+  BlePeripheralPlugin::NotifyResult BlePeripheralPlugin::NotifyValue(
+      const std::string &characteristicId,
+      const uint8_t *value,
+      size_t length,
+      const std::string *deviceId)
+  {
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
+    if (gattCharacteristicObject == nullptr)
+      return NotifyResult::CharacteristicNotFound;
+
+    GattSubscribedClient subscribedClient{nullptr};
+    if (deviceId != nullptr)
+    {
+      {
+        std::lock_guard<std::mutex> lock(gattCharacteristicObject->subscribers_mutex);
+        auto it = gattCharacteristicObject->subscribers.find(*deviceId);
+        if (it != gattCharacteristicObject->subscribers.end())
+          subscribedClient = it->second;
+      }
+      if (subscribedClient == nullptr)
+        return NotifyResult::DeviceNotSubscribed;
+
+      // A notification carries at most ATT_MTU - 3 bytes of value
+      std::optional<uint16_t> maxPduSize = sessions_->MaxPduSize(*deviceId);
+      if (maxPduSize.has_value() && length + 3 > *maxPduSize)
+        return NotifyResult::ValueExceedsMtu;
+    }
+
+    // The value is copied once, straight into the buffer handed to WinRT
+    Buffer buffer(static_cast<uint32_t>(length));
+    if (length > 0)
+      std::memcpy(buffer.data(), value, length);
+    buffer.Length(static_cast<uint32_t>(length));
+
+    if (subscribedClient == nullptr)
+      gattCharacteristicObject->obj.NotifyValueAsync(buffer);
+    else
+      gattCharacteristicObject->obj.NotifyValueAsync(buffer, subscribedClient);
+    return NotifyResult::Sent;
+  }
+
+  void BlePeripheralPlugin::StartWriteRing(std::shared_ptr<WriteRing> writeRing)
+  {
+    // WinRT threads may still hold the previous ring, it is freed after their last append
+    std::atomic_store(&writeRing_, std::move(writeRing));
+  }
+
+  void BlePeripheralPlugin::StopWriteRing()
+  {
+    std::atomic_store(&writeRing_, std::shared_ptr<WriteRing>());
+  }
+
+  // Helpers
+  std::optional<FlutterError> BlePeripheralPlugin::SetWriteStreamConfig(
+      const std::string &characteristic_id,
+      const WriteStreamConfig *config)
+  {
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristic_id);
     if (gattCharacteristicObject == nullptr)
       return FlutterError("Failed to get this characteristic");
 
-    IBuffer bytes = from_bytevc(value);
-    DataWriter writer;
-    writer.ByteOrder(ByteOrder::LittleEndian);
-    writer.WriteBuffer(bytes);
-    gattCharacteristicObject->obj.NotifyValueAsync(writer.DetachBuffer());
+    std::shared_ptr<WriteStream> writeStream = nullptr;
+    if (config != nullptr)
+    {
+      if (config->max_batch_count() <= 0 || config->max_batch_bytes() <= 0 ||
+          config->max_latency_ms() <= 0 || config->capacity_bytes() <= 0)
+        return FlutterError("Invalid write stream config, all values must be positive");
+
+      BatchFlushPolicy policy;
+      policy.maxCount = static_cast<size_t>(config->max_batch_count());
+      policy.maxBytes = static_cast<size_t>(config->max_batch_bytes());
+      policy.maxLatency = std::chrono::milliseconds(config->max_latency_ms());
+
+      std::string characteristicId = characteristic_id;
+      writeStream = std::make_shared<WriteStream>(
+          policy, static_cast<size_t>(config->capacity_bytes()),
+          [this, characteristicId](WriteStreamChunk &&chunk, std::function<void()> &&onDelivered)
+          {
+            uiThreadHandler_.Post([characteristicId, chunk = std::move(chunk), onDelivered = std::move(onDelivered)]
+                                  {
+                                    flutter::EncodableList lengths;
+                                    lengths.reserve(chunk.lengths.size());
+                                    for (uint32_t length : chunk.lengths)
+                                      lengths.push_back(EncodableValue(static_cast<int64_t>(length)));
+
+                                    WriteStreamBatch batch(
+                                        chunk.deviceId, characteristicId, chunk.data, lengths,
+                                        static_cast<int64_t>(chunk.droppedPackets),
+                                        static_cast<int64_t>(chunk.droppedBytes));
+                                    bleCallback->OnWriteStream(
+                                        batch,
+                                        // SuccessCallback
+                                        [onDelivered]()
+                                        { onDelivered(); },
+                                        // ErrorCallback
+                                        [onDelivered](const FlutterError &error)
+                                        {
+                                          BLE_LOG_ERROR("ErrorCallback: ", error.message());
+                                          onDelivered();
+                                        }); });
+          });
+    }
+
+    // Deliver whatever the previous stream still buffers
+    auto previous = std::atomic_exchange(&gattCharacteristicObject->write_stream, writeStream);
+    if (previous != nullptr)
+      previous->Close();
     return std::nullopt;
   }
 
-  // Helpers
-  winrt::fire_and_forget BlePeripheralPlugin::AddServiceAsync(const BleService &service)
+  std::optional<FlutterError> BlePeripheralPlugin::SetCharacteristicWritePolicy(
+      const std::string &characteristic_id,
+      const CharacteristicWritePolicy *policy)
+  {
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristic_id);
+    if (gattCharacteristicObject == nullptr)
+      return FlutterError("Failed to get this characteristic");
+
+    std::shared_ptr<const WritePolicy> writePolicy = nullptr;
+    if (policy != nullptr)
+    {
+      auto newPolicy = std::make_shared<WritePolicy>();
+      newPolicy->acknowledgeImmediately = policy->acknowledge_immediately();
+      if (policy->min_length() != nullptr)
+        newPolicy->minLength = static_cast<size_t>(*policy->min_length());
+      if (policy->max_length() != nullptr)
+        newPolicy->maxLength = static_cast<size_t>(*policy->max_length());
+      if (policy->allowed_offsets() != nullptr)
+      {
+        for (const auto &allowedOffset : *policy->allowed_offsets())
+          newPolicy->allowedOffsets.push_back(std::get<int64_t>(allowedOffset));
+      }
+      writePolicy = newPolicy;
+    }
+
+    std::atomic_store(&gattCharacteristicObject->write_policy, writePolicy);
+    return std::nullopt;
+  }
+
+  std::optional<FlutterError> BlePeripheralPlugin::SetWriteBatchPolicy(const WriteBatchPolicy *policy)
+  {
+    std::shared_ptr<WriteRequestBatcher> writeBatcher = nullptr;
+    if (policy != nullptr)
+    {
+      if (policy->max_count() <= 0 || policy->max_bytes() <= 0 || policy->max_latency_ms() <= 0)
+        return FlutterError("Invalid write batch policy, all values must be positive");
+
+      BatchFlushPolicy flushPolicy;
+      flushPolicy.maxCount = static_cast<size_t>(policy->max_count());
+      flushPolicy.maxBytes = static_cast<size_t>(policy->max_bytes());
+      flushPolicy.maxLatency = std::chrono::milliseconds(policy->max_latency_ms());
+
+      writeBatcher = std::make_shared<WriteRequestBatcher>(
+          flushPolicy,
+          [this](WriteRequestRecords &&records)
+          {
+            uiThreadHandler_.Post([records = std::move(records)]
+                                  {
+                                    flutter::EncodableList deviceIds(records.deviceIds.begin(), records.deviceIds.end());
+                                    flutter::EncodableList characteristicIds(records.characteristicIds.begin(), records.characteristicIds.end());
+                                    flutter::EncodableList offsets(records.offsets.begin(), records.offsets.end());
+                                    flutter::EncodableList lengths;
+                                    lengths.reserve(records.lengths.size());
+                                    for (uint32_t length : records.lengths)
+                                      lengths.push_back(EncodableValue(static_cast<int64_t>(length)));
+
+                                    WriteRequestBatch batch(deviceIds, characteristicIds, offsets, records.values, lengths);
+                                    bleCallback->OnWriteRequestsBatch(
+                                        batch,
+                                        // SuccessCallback
+                                        []() {},
+                                        // ErrorCallback
+                                        [](const FlutterError &error)
+                                        { BLE_LOG_ERROR("ErrorCallback: ", error.message()); }); });
+          });
+    }
+
+    // Deliver whatever the previous batcher still buffers
+    auto previous = std::atomic_exchange(&writeBatcher_, writeBatcher);
+    if (previous != nullptr)
+      previous->Close();
+    return std::nullopt;
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::AddServiceAsync(BleService service)
+  {
+    auto serviceUuid = service.uuid();
+    std::string error = winrt::to_string(co_await BuildServiceAsync(service));
+
+    uiThreadHandler_.Post([serviceUuid, error]
+                          { bleCallback->OnServiceAdded(serviceUuid, error.empty() ? nullptr : &error, SuccessCallback, ErrorCallback); });
+  }
+
+  void BlePeripheralPlugin::AddServices(
+      const flutter::EncodableList &services,
+      std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    std::vector<BleService> serviceList;
+    serviceList.reserve(services.size());
+    for (const auto &serviceEncoded : services)
+      serviceList.push_back(std::any_cast<const BleService &>(std::get<flutter::CustomEncodableValue>(serviceEncoded)));
+    AddServicesAsync(std::move(serviceList), std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::AddServicesAsync(std::vector<BleService> services,
+                                                               std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    // Providers of different services are built concurrently as well, up to kMaxInFlightServices at a time
+    std::vector<hstring> errors(services.size());
+    AsyncWindow<hstring> serviceWindow(kMaxInFlightServices);
+    for (size_t i = 0; i < services.size(); ++i)
+    {
+      if (serviceWindow.full())
+      {
+        auto [index, operation] = serviceWindow.PopOldest();
+        errors[index] = co_await operation;
+      }
+      serviceWindow.Push(i, BuildServiceAsync(services[i]));
+    }
+    while (!serviceWindow.empty())
+    {
+      auto [index, operation] = serviceWindow.PopOldest();
+      errors[index] = co_await operation;
+    }
+
+    flutter::EncodableMap failedServices;
+    for (size_t i = 0; i < services.size(); ++i)
+    {
+      if (!errors[i].empty())
+        failedServices.insert_or_assign(EncodableValue(services[i].uuid()), EncodableValue(winrt::to_string(errors[i])));
+    }
+    BLE_LOG_INFO("Added ", services.size() - failedServices.size(), " of ", services.size(), " services");
+
+    uiThreadHandler_.Post([result, failedServices]
+                          { result(failedServices); });
+  }
+
+  void BlePeripheralPlugin::LoadGattDatabase(
+      const std::string &path,
+      std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    LoadGattDatabaseAsync(path, false, std::move(result));
+  }
+
+  void BlePeripheralPlugin::ApplyGattDatabase(
+      const std::string &path,
+      std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    LoadGattDatabaseAsync(path, true, std::move(result));
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::LoadGattDatabaseAsync(std::string path, bool incremental,
+                                                                    std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    // Read and validate off the platform thread, the services never pass through the channel codec
+    co_await winrt::resume_background();
+
+    std::optional<std::vector<BleService>> services = ReadGattDatabase(path, result);
+    if (!services.has_value())
+      co_return;
+
+    if (!incremental)
+    {
+      AddServicesAsync(std::move(*services), std::move(result));
+      co_return;
+    }
+
+    // Applied on the platform thread, so concurrent applyGattDatabase calls can not interleave their diffs
+    uiThreadHandler_.Post([this, services = std::move(*services), result]
+                          { ApplyServices(services, result); });
+  }
+
+  ErrorOr<flutter::EncodableMap> BlePeripheralPlugin::GetNativeStats()
+  {
+    flutter::EncodableMap stats;
+    stats.insert_or_assign(EncodableValue("liveServices"), EncodableValue(GattObjectStats::services.load()));
+    stats.insert_or_assign(EncodableValue("liveCharacteristics"), EncodableValue(GattObjectStats::characteristics.load()));
+    stats.insert_or_assign(EncodableValue("gattObjectBytes"), EncodableValue(GattObjectStats::bytes.load()));
+    if (bleCallback != nullptr)
+    {
+      BleCallbackDispatcher::Stats callbacks = bleCallback->stats();
+      stats.insert_or_assign(EncodableValue("callbacksSent"), EncodableValue(callbacks.sent));
+      stats.insert_or_assign(EncodableValue("callbackSendNanos"), EncodableValue(callbacks.sendNanos));
+      stats.insert_or_assign(EncodableValue("callbackReplies"), EncodableValue(callbacks.replies));
+      stats.insert_or_assign(EncodableValue("callbackReplyNanos"), EncodableValue(callbacks.replyNanos));
+      stats.insert_or_assign(EncodableValue("binaryCallbacksSent"), EncodableValue(callbacks.binarySent));
+      stats.insert_or_assign(EncodableValue("binaryCallbackSendNanos"), EncodableValue(callbacks.binarySendNanos));
+      stats.insert_or_assign(EncodableValue("binaryCallbackReplies"), EncodableValue(callbacks.binaryReplies));
+      stats.insert_or_assign(EncodableValue("binaryCallbackReplyNanos"), EncodableValue(callbacks.binaryReplyNanos));
+    }
+    auto writeRing = std::atomic_load(&writeRing_);
+    if (writeRing != nullptr)
+      stats.insert_or_assign(EncodableValue("writeRingDropped"), EncodableValue(static_cast<int64_t>(writeRing->dropped())));
+    stats.insert_or_assign(EncodableValue("logDropped"), EncodableValue(static_cast<int64_t>(Logger::Instance().dropped())));
+    return stats;
+  }
+
+  std::optional<std::vector<BleService>> BlePeripheralPlugin::ReadGattDatabase(
+      const std::string &path,
+      const std::function<void(ErrorOr<flutter::EncodableMap> reply)> &result)
+  {
+    std::ifstream file(std::filesystem::path(winrt::to_hstring(path).c_str()), std::ios::binary);
+    if (!file)
+    {
+      std::string err = "Failed to open GATT database: " + path;
+      uiThreadHandler_.Post([result, err]
+                            { result(FlutterError("file-not-found", err)); });
+      return std::nullopt;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    GattDatabase database = ParseGattDatabase(std::wstring(winrt::to_hstring(content)));
+    if (!database.errors.empty())
+    {
+      std::string message = std::to_string(database.errors.size()) + " errors in GATT database " + path;
+      flutter::EncodableList errors;
+      for (const auto &error : database.errors)
+      {
+        message += "\n" + error;
+        errors.push_back(EncodableValue(error));
+      }
+      BLE_LOG_WARNING(message);
+      uiThreadHandler_.Post([result, message, errors]
+                            { result(FlutterError("invalid-gatt-database", message, EncodableValue(errors))); });
+      return std::nullopt;
+    }
+    return std::move(database.services);
+  }
+
+  void BlePeripheralPlugin::ApplyServices(std::vector<BleService> services,
+                                          std::function<void(ErrorOr<flutter::EncodableMap> reply)> result)
+  {
+    std::set<std::string> desiredServices;
+    std::set<std::string> readvertise;
+    std::vector<BleService> rebuilt;
+    size_t updatedValues = 0;
+    auto registered = serviceRegistry_.snapshot();
+
+    for (auto &service : services)
+    {
+      std::string serviceId = to_lower_case(service.uuid());
+      desiredServices.insert(serviceId);
+      std::string layout = GattServiceLayout(service);
+
+      auto it = registered->services.find(serviceId);
+      if (it != registered->services.end() && it->second->layout == layout)
+      {
+        // Same structure, the provider and its subscribers stay, only values are swapped
+        for (const auto &characteristicEncoded : service.characteristics())
+        {
+          const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristicEncoded));
+          auto characteristicIt = it->second->characteristics.find(to_lower_case(characteristic.uuid()));
+          if (characteristicIt == it->second->characteristics.end())
+            continue;
+
+          GattCharacteristicObject *gattCharacteristicObject = characteristicIt->second;
+          auto current = std::atomic_load(&gattCharacteristicObject->value);
+          const std::vector<uint8_t> *value = characteristic.value();
+          bool unchanged = value == nullptr ? current == nullptr : current != nullptr && *current == *value;
+          if (unchanged)
+            continue;
+
+          std::atomic_store(&gattCharacteristicObject->value,
+                            value == nullptr ? std::shared_ptr<const std::vector<uint8_t>>() : std::make_shared<const std::vector<uint8_t>>(*value));
+          updatedValues++;
+        }
+        continue;
+      }
+
+      if (auto previous = serviceRegistry_.Remove(serviceId))
+      {
+        if (advertisingStatus_.IsStarted(previous->obj))
+          readvertise.insert(serviceId);
+        disposeGattServiceObject(previous.get());
+      }
+      rebuilt.push_back(std::move(service));
+    }
+
+    // Services missing from the database are removed
+    size_t removed = 0;
+    for (auto const &[serviceId, gattServiceObject] : registered->services)
+    {
+      if (desiredServices.count(serviceId) != 0)
+        continue;
+      if (auto previous = serviceRegistry_.Remove(serviceId))
+      {
+        disposeGattServiceObject(previous.get());
+        removed++;
+      }
+    }
+
+    BLE_LOG_INFO("Applying GATT database: ", rebuilt.size(), " services to build, ", removed, " removed, ", updatedValues, " values updated");
+
+    AddServicesAsync(std::move(rebuilt), [this, readvertise, result](ErrorOr<flutter::EncodableMap> reply)
+                     {
+                       // Rebuilt services resume advertising if their previous provider was advertising
+                       auto advertisementParameter = GattServiceProviderAdvertisingParameters();
+                       advertisementParameter.IsDiscoverable(true);
+                       advertisementParameter.IsConnectable(true);
+                       for (const auto &serviceId : readvertise)
+                       {
+                         auto gattServiceObject = serviceRegistry_.Find(serviceId);
+                         if (gattServiceObject == nullptr)
+                           continue;
+                         try
+                         {
+                           gattServiceObject->obj.StartAdvertising(advertisementParameter);
+                         }
+                         catch (const winrt::hresult_error &e)
+                         {
+                           BLE_LOG_ERROR("Failed to restart advertising of ", serviceId, ", Error: ", e.message());
+                         }
+                       }
+                       result(std::move(reply)); });
+  }
+
+  IAsyncOperation<hstring> BlePeripheralPlugin::BuildServiceAsync(BleService service)
   {
     auto serviceUuid = service.uuid();
+    ServiceBuildTimings timings;
+    auto buildStart = std::chrono::steady_clock::now();
+    auto stepStart = buildStart;
+    auto elapsed = [&stepStart]()
+    {
+      auto now = std::chrono::steady_clock::now();
+      auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - stepStart);
+      stepStart = now;
+      return duration;
+    };
+
     try
     {
       // Build Service
-      auto characteristics = service.characteristics();
-      auto gattCharacteristicObjList = std::map<std::string, GattCharacteristicObject *>();
+      const flutter::EncodableList &characteristics = service.characteristics();
 
       auto serviceProviderResult = co_await GattServiceProvider::CreateAsync(uuid_to_guid(serviceUuid));
       if (serviceProviderResult.Error() != BluetoothError::Success)
       {
         std::string bleError = ParseBluetoothError(serviceProviderResult.Error());
         std::string err = "Failed to create service provider: " + serviceUuid + ", errorCode: " + bleError;
-        std::cout << err << std::endl;
-        bleCallback->OnServiceAdded(serviceUuid, &err, SuccessCallback, ErrorCallback);
-        co_return;
+        BLE_LOG_ERROR(err);
+        co_return winrt::to_hstring(err);
       }
 
       GattServiceProvider serviceProvider = serviceProviderResult.ServiceProvider();
+      timings.provider = elapsed();
 
-      // Build Characteristic
-      for (auto characteristicEncoded : characteristics)
+      // Build Characteristics, creations are issued in declaration order and overlap up to kMaxInFlightCreations
+      std::vector<GattLocalCharacteristicResult> characteristicResults(characteristics.size(), nullptr);
+      AsyncWindow<GattLocalCharacteristicResult> characteristicWindow(kMaxInFlightCreations);
+      for (size_t i = 0; i < characteristics.size(); ++i)
       {
-        BleCharacteristic characteristic = std::any_cast<BleCharacteristic>(std::get<flutter::CustomEncodableValue>(characteristicEncoded));
-        flutter::EncodableList descriptors = characteristic.descriptors() == nullptr ? flutter::EncodableList() : *characteristic.descriptors();
+        const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristics[i]));
 
         auto charParameters = GattLocalCharacteristicParameters();
-        auto characteristicUuid = characteristic.uuid();
 
         // Add characteristic properties
-        auto charProperties = characteristic.properties();
-        for (flutter::EncodableValue propertyEncoded : charProperties)
+        for (flutter::EncodableValue propertyEncoded : characteristic.properties())
         {
           int property = static_cast<int>(std::get<int64_t>(propertyEncoded));
           charParameters.CharacteristicProperties(charParameters.CharacteristicProperties() | toGattCharacteristicProperties(property));
         }
 
         // Add characteristic permissions
-        auto charPermissions = characteristic.permissions();
-        for (flutter::EncodableValue permissionEncoded : charPermissions)
+        for (flutter::EncodableValue permissionEncoded : characteristic.permissions())
         {
           auto blePermission = toBlePermission(static_cast<int>(std::get<int64_t>(permissionEncoded)));
           switch (blePermission)
@@ -271,34 +1105,47 @@ namespace ble_peripheral
           }
         }
 
-        const std::vector<uint8_t> *characteristicValue = characteristic.value();
-        if (characteristicValue != nullptr)
+        // The value is not a StaticValue, it lives in GattCharacteristicObject so applyGattDatabase can replace it
+
+        if (characteristicWindow.full())
         {
-          auto characteristicBytes = from_bytevc(*characteristicValue);
-          charParameters.StaticValue(characteristicBytes);
+          auto [index, operation] = characteristicWindow.PopOldest();
+          characteristicResults[index] = co_await operation;
         }
+        characteristicWindow.Push(i, serviceProvider.Service().CreateCharacteristicAsync(uuid_to_guid(characteristic.uuid()), charParameters));
+      }
+      while (!characteristicWindow.empty())
+      {
+        auto [index, operation] = characteristicWindow.PopOldest();
+        characteristicResults[index] = co_await operation;
+      }
 
-        auto characteristicResult = co_await serviceProvider.Service().CreateCharacteristicAsync(uuid_to_guid(characteristicUuid), charParameters);
-        if (characteristicResult.Error() != BluetoothError::Success)
+      for (size_t i = 0; i < characteristicResults.size(); ++i)
+      {
+        if (characteristicResults[i].Error() != BluetoothError::Success)
         {
-          std::wcerr << "Failed to create Char Provider: " << std::endl;
-          co_return;
+          const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristics[i]));
+          std::string err = "Failed to create characteristic: " + characteristic.uuid() + ", errorCode: " + ParseBluetoothError(characteristicResults[i].Error());
+          BLE_LOG_ERROR(err);
+          co_return winrt::to_hstring(err);
         }
-        auto gattCharacteristic = characteristicResult.Characteristic();
-
-        auto gattCharacteristicObject = new GattCharacteristicObject();
-        gattCharacteristicObject->obj = gattCharacteristic;
-        gattCharacteristicObject->stored_clients = gattCharacteristic.SubscribedClients();
+      }
+      timings.characteristics = elapsed();
 
-        gattCharacteristicObject->read_requested_token = gattCharacteristic.ReadRequested({this, &BlePeripheralPlugin::ReadRequestedAsync});
-        gattCharacteristicObject->write_requested_token = gattCharacteristic.WriteRequested({this, &BlePeripheralPlugin::WriteRequestedAsync});
-        gattCharacteristicObject->value_changed_token = gattCharacteristic.SubscribedClientsChanged({this, &BlePeripheralPlugin::SubscribedClientsChanged});
+      // Build Descriptors, in declaration order once their characteristic exists
+      std::vector<std::string> descriptorUuids;
+      AsyncWindow<GattLocalDescriptorResult> descriptorWindow(kMaxInFlightCreations);
+      std::vector<GattLocalDescriptorResult> descriptorResults;
+      for (size_t i = 0; i < characteristics.size(); ++i)
+      {
+        const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristics[i]));
+        if (characteristic.descriptors() == nullptr)
+          continue;
 
-        // Build Descriptors
-        for (flutter::EncodableValue descriptorEncoded : descriptors)
+        GattLocalCharacteristic gattCharacteristic = characteristicResults[i].Characteristic();
+        for (const flutter::EncodableValue &descriptorEncoded : *characteristic.descriptors())
         {
-          BleDescriptor descriptor = std::any_cast<BleDescriptor>(std::get<flutter::CustomEncodableValue>(descriptorEncoded));
-          auto descriptorUuid = descriptor.uuid();
+          const auto &descriptor = std::any_cast<const BleDescriptor &>(std::get<flutter::CustomEncodableValue>(descriptorEncoded));
           auto descriptorParameters = GattLocalDescriptorParameters();
 
           // Add descriptor permissions
@@ -328,49 +1175,81 @@ namespace ble_peripheral
             auto descriptorBytes = from_bytevc(*descriptorValue);
             descriptorParameters.StaticValue(descriptorBytes);
           }
-          auto descriptorResult = co_await gattCharacteristic.CreateDescriptorAsync(uuid_to_guid(descriptorUuid), descriptorParameters);
-          if (descriptorResult.Error() != BluetoothError::Success)
+
+          if (descriptorWindow.full())
           {
-            std::wcerr << "Failed to create Descriptor Provider: " << std::endl;
-            co_return;
+            auto [index, operation] = descriptorWindow.PopOldest();
+            descriptorResults[index] = co_await operation;
           }
-          GattLocalDescriptor gattDescriptor = descriptorResult.Descriptor();
+          descriptorWindow.Push(descriptorResults.size(), gattCharacteristic.CreateDescriptorAsync(uuid_to_guid(descriptor.uuid()), descriptorParameters));
+          descriptorResults.push_back(nullptr);
+          descriptorUuids.push_back(descriptor.uuid());
         }
+      }
+      while (!descriptorWindow.empty())
+      {
+        auto [index, operation] = descriptorWindow.PopOldest();
+        descriptorResults[index] = co_await operation;
+      }
 
-        gattCharacteristicObjList.insert_or_assign(guid_to_uuid(gattCharacteristic.Uuid()), gattCharacteristicObject);
+      for (size_t i = 0; i < descriptorResults.size(); ++i)
+      {
+        if (descriptorResults[i].Error() != BluetoothError::Success)
+        {
+          std::string err = "Failed to create descriptor: " + descriptorUuids[i] + ", errorCode: " + ParseBluetoothError(descriptorResults[i].Error());
+          BLE_LOG_ERROR(err);
+          co_return winrt::to_hstring(err);
+        }
+      }
+      timings.descriptors = elapsed();
+
+      // Register handlers only once the whole service was created
+      auto gattServiceProviderObject = std::make_shared<GattServiceProviderObject>();
+      for (size_t i = 0; i < characteristicResults.size(); ++i)
+      {
+        const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristics[i]));
+        auto gattCharacteristic = characteristicResults[i].Characteristic();
+
+        GattCharacteristicObject *gattCharacteristicObject = &gattServiceProviderObject->characteristic_slab.emplace_back();
+        gattCharacteristicObject->obj = gattCharacteristic;
+        if (characteristic.value() != nullptr)
+          gattCharacteristicObject->value = std::make_shared<const std::vector<uint8_t>>(*characteristic.value());
+
+        gattCharacteristicObject->read_requested_token = gattCharacteristic.ReadRequested({this, &BlePeripheralPlugin::ReadRequestedAsync});
+        gattCharacteristicObject->write_requested_token = gattCharacteristic.WriteRequested({this, &BlePeripheralPlugin::WriteRequestedAsync});
+        gattCharacteristicObject->value_changed_token = gattCharacteristic.SubscribedClientsChanged({this, &BlePeripheralPlugin::SubscribedClientsChanged});
+
+        gattServiceProviderObject->characteristics.insert_or_assign(guid_to_uuid(gattCharacteristic.Uuid()), gattCharacteristicObject);
       }
 
-      GattServiceProviderObject *gattServiceProviderObject = new GattServiceProviderObject();
       gattServiceProviderObject->obj = serviceProvider;
-      gattServiceProviderObject->characteristics = gattCharacteristicObjList;
+      gattServiceProviderObject->layout = GattServiceLayout(service);
+      advertisingStatus_.Track(serviceProvider, serviceProvider.AdvertisementStatus());
       gattServiceProviderObject->advertisement_status_changed_token = serviceProvider.AdvertisementStatusChanged({this, &BlePeripheralPlugin::ServiceProvider_AdvertisementStatusChanged});
-      serviceProviderMap.insert_or_assign(guid_to_uuid(serviceProvider.Service().Uuid()), gattServiceProviderObject);
 
-      uiThreadHandler_.Post([serviceUuid]
-                            { bleCallback->OnServiceAdded(serviceUuid, nullptr, SuccessCallback, ErrorCallback); });
+      // A service added again replaces the previous one, which is released once its handlers are done
+      std::string serviceId = guid_to_uuid(serviceProvider.Service().Uuid());
+      if (auto previous = serviceRegistry_.Insert(serviceId, std::move(gattServiceProviderObject)))
+        disposeGattServiceObject(previous.get());
+
+      timings.total = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart);
+      BLE_LOG_DEBUG("Service ", serviceUuid, " built in ", timings.total.count(), "us", " (provider ", timings.provider.count(), "us", ", ", characteristicResults.size(), " characteristics ", timings.characteristics.count(), "us", ", ", descriptorResults.size(), " descriptors ", timings.descriptors.count(), "us)");
+      co_return hstring();
     }
     catch (const winrt::hresult_error &e)
     {
-      std::wcerr << "Failed with error: Code: " << e.code() << "Message: " << e.message().c_str() << std::endl;
-      std::string errorMessage = winrt::to_string(e.message());
-
-      uiThreadHandler_.Post([serviceUuid, errorMessage]
-                            { bleCallback->OnServiceAdded(serviceUuid, &errorMessage, SuccessCallback, ErrorCallback); });
+      BLE_LOG_ERROR("Failed with error: Code: ", e.code(), "Message: ", e.message());
+      co_return e.message();
     }
     catch (const std::exception &e)
     {
-      std::cout << "Error: " << e.what() << std::endl;
-      std::wstring errorMessage = winrt::to_hstring(e.what()).c_str();
-      std::string *err = new std::string(winrt::to_string(errorMessage));
-      uiThreadHandler_.Post([serviceUuid, err]
-                            { bleCallback->OnServiceAdded(serviceUuid, err, SuccessCallback, ErrorCallback); });
+      BLE_LOG_ERROR("Error: ", e.what());
+      co_return winrt::to_hstring(e.what());
     }
     catch (...)
     {
-      std::cout << "Error: Unknown error" << std::endl;
-      std::string *err = new std::string(winrt::to_string(L"Unknown error"));
-      uiThreadHandler_.Post([serviceUuid, err]
-                            { bleCallback->OnServiceAdded(serviceUuid, err, SuccessCallback, ErrorCallback); });
+      BLE_LOG_ERROR("Error: Unknown error");
+      co_return hstring(L"Unknown error");
     }
   }
 
@@ -379,190 +1258,215 @@ namespace ble_peripheral
   /// Advertisements Listener
   void BlePeripheralPlugin::ServiceProvider_AdvertisementStatusChanged(GattServiceProvider const &sender, GattServiceProviderAdvertisementStatusChangedEventArgs const &args)
   {
-    std::lock_guard<std::mutex> lock(cout_mutex);
+    auto argStatus = args.Status();
+    auto transition = advertisingStatus_.Update(sender, argStatus);
     auto serviceUuid = guid_to_uuid(sender.Service().Uuid());
     if (args.Error() != BluetoothError::Success)
     {
       std::string errorStr = ParseBluetoothError(args.Error());
-      std::cout << "AdvertisementStatusChanged " << serviceUuid << ", Error " << errorStr << std::endl;
+      BLE_LOG_ERROR("AdvertisementStatusChanged ", serviceUuid, ", Error ", errorStr);
 
       uiThreadHandler_.Post([errorStr]
                             { bleCallback->OnAdvertisingStatusUpdate(false, &errorStr, SuccessCallback, ErrorCallback); });
       return;
     }
 
-    auto argStatus = args.Status();
-    auto statusStr = AdvertisementStatusToString(argStatus);
-    std::cout << "AdvertisingStatus of service " << serviceUuid << ", changed to " << statusStr << " " << std::endl;
+    BLE_LOG_DEBUG("AdvertisingStatus of service ", serviceUuid, ", changed to ", AdvertisementStatusToString(argStatus));
 
-    // Check if all services started
-    if (AreAllServicesStarted())
-    {
-      uiThreadHandler_.Post([]
-                            { bleCallback->OnAdvertisingStatusUpdate(true, nullptr, SuccessCallback, ErrorCallback); });
-    }
+    // Only changes of whether all services advertise are reported, not every service event
+    if (transition == AdvertisingStatusTracker::Transition::None)
+      return;
+    bool advertising = transition == AdvertisingStatusTracker::Transition::AllStarted;
+    uiThreadHandler_.Post([advertising]
+                          { bleCallback->OnAdvertisingStatusUpdate(advertising, nullptr, SuccessCallback, ErrorCallback); });
   }
 
   /// Characteristic Listeners
-  winrt::fire_and_forget BlePeripheralPlugin::SubscribedClientsChanged(GattLocalCharacteristic const &localChar, IInspectable const &)
+  void BlePeripheralPlugin::SubscribedClientsChanged(GattLocalCharacteristic const &localChar, IInspectable const &)
   {
     auto characteristicId = guid_to_uuid(localChar.Uuid());
 
     // Find GattCharacteristicObject
-    GattCharacteristicObject *gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
 
     if (gattCharacteristicObject == nullptr)
     {
-      std::cout << "Failed to get char " << characteristicId << std::endl;
-      co_return;
+      BLE_LOG_ERROR("Failed to get char ", characteristicId);
+      return;
     }
 
-    // Compare Stored clients and New clients
-    IVectorView<GattSubscribedClient> currentClients = localChar.SubscribedClients();
-    IVectorView<GattSubscribedClient> oldClients = gattCharacteristicObject->stored_clients;
+    // Walk the current clients once, then diff against the stored set by device id
+    std::unordered_map<std::string, GattSubscribedClient> currentClients;
+    for (GattSubscribedClient const &client : localChar.SubscribedClients())
+    {
+      GattSession session = client.Session();
+      std::string deviceId = ParseBluetoothClientId(session.DeviceId().Id());
+      sessions_->Track(deviceId, session);
+      currentClients.emplace(deviceId, client);
+    }
 
-    // Check if any client removed
-    for (unsigned int i = 0; i < oldClients.Size(); ++i)
+    std::vector<std::pair<std::string, GattSubscribedClient>> addedClients;
+    std::vector<std::pair<std::string, GattSubscribedClient>> removedClients;
     {
-      auto oldClient = oldClients.GetAt(i);
-      bool found = false;
-      for (unsigned int j = 0; j < currentClients.Size(); ++j)
+      std::lock_guard<std::mutex> lock(gattCharacteristicObject->subscribers_mutex);
+      auto &oldClients = gattCharacteristicObject->subscribers;
+      for (const auto &[deviceId, client] : oldClients)
       {
-        if (currentClients.GetAt(j) == oldClient)
-        {
-          found = true;
-          break;
-        }
+        if (currentClients.find(deviceId) == currentClients.end())
+          removedClients.emplace_back(deviceId, client);
       }
-      if (!found)
+      for (const auto &[deviceId, client] : currentClients)
       {
-        // oldClient is not in currentClients, so it was removed
-        std::string deviceIdArg = ParseBluetoothClientId(oldClient.Session().DeviceId().Id());
-        try
-        {
-          auto deviceInfo = co_await DeviceInformation::CreateFromIdAsync(oldClient.Session().DeviceId().Id());
-          auto deviceName = winrt::to_string(deviceInfo.Name());
-          uiThreadHandler_.Post([deviceName, deviceIdArg, characteristicId]
-                                {
-                                  bleCallback->OnCharacteristicSubscriptionChange(
-                                      deviceIdArg, characteristicId, false, &deviceName,
-                                      SuccessCallback, ErrorCallback);
-                                  // Notify subscription change
-                                });
-          // Point to the local variable
-        }
-        catch (...)
-        {
-          std::cerr << "Failed to retrieve device name" << std::endl;
-        }
+        if (oldClients.find(deviceId) == oldClients.end())
+          addedClients.emplace_back(deviceId, client);
       }
+      oldClients = std::move(currentClients);
     }
 
-    // Check if any client added
-    for (unsigned int i = 0; i < currentClients.Size(); ++i)
-    {
-      auto currentClient = currentClients.GetAt(i);
-      bool found = false;
-      for (unsigned int j = 0; j < oldClients.Size(); ++j)
-      {
-        if (oldClients.GetAt(j) == currentClient)
-        {
-          found = true;
-          break;
-        }
-      }
-      if (!found)
-      {
-        // currentClient is not in oldClients, so it was added
-        std::string deviceIdArg = ParseBluetoothClientId(currentClient.Session().DeviceId().Id());
+    for (const auto &[deviceId, client] : removedClients)
+      NotifySubscriptionChange(client.Session(), deviceId, characteristicId, false);
 
-        try
-        {
-          auto deviceInfo = co_await DeviceInformation::CreateFromIdAsync(currentClient.Session().DeviceId().Id());
-          auto deviceName = winrt::to_string(deviceInfo.Name());
-          uiThreadHandler_.Post([deviceName, deviceIdArg, characteristicId]
-                                {
-                                  bleCallback->OnCharacteristicSubscriptionChange(
-                                      deviceIdArg, characteristicId, true, &deviceName,
-                                      SuccessCallback, ErrorCallback);
-                                  // Notify subscription change
-                                });
-          // Point to the local variable
-        }
-        catch (...)
-        {
-          std::cerr << "Failed to retrieve device name" << std::endl;
-        }
+    // Names of new clients are resolved concurrently, no lookup blocks the next client,
+    // their MTU is reported by the session registry
+    for (const auto &[deviceId, client] : addedClients)
+      NotifySubscriptionChange(client.Session(), deviceId, characteristicId, true);
+  }
 
-        int64_t maxPuid = currentClient.Session().MaxPduSize();
-        uiThreadHandler_.Post([deviceIdArg, maxPuid]
-                              {
-                                bleCallback->OnMtuChange(deviceIdArg, maxPuid,
-                                                         SuccessCallback, ErrorCallback);
-                                // Notify added device MTU change
-                              });
-      }
+  void BlePeripheralPlugin::NotifySubscriptionChange(GattSession session, std::string deviceId, std::string characteristicId, bool isSubscribed)
+  {
+    // Never wait for the device name, it follows in a second event if not cached yet
+    std::optional<std::string> deviceName = deviceNames_.Get(deviceId);
+    uiThreadHandler_.Post([deviceId, characteristicId, isSubscribed, deviceName]
+                          {
+                            bleCallback->OnCharacteristicSubscriptionChange(
+                                deviceId, characteristicId, isSubscribed,
+                                deviceName.has_value() ? &deviceName.value() : nullptr,
+                                SuccessCallback, ErrorCallback);
+                            // Notify subscription change
+                          });
+
+    if (!deviceName.has_value() && deviceNames_.AddPending(deviceId, {characteristicId, isSubscribed}))
+      ResolveDeviceName(session.DeviceId().Id(), deviceId);
+  }
+
+  winrt::fire_and_forget BlePeripheralPlugin::ResolveDeviceName(hstring bluetoothDeviceId, std::string deviceId)
+  {
+    std::optional<std::string> deviceName;
+    try
+    {
+      auto deviceInfo = co_await DeviceInformation::CreateFromIdAsync(bluetoothDeviceId);
+      deviceName = winrt::to_string(deviceInfo.Name());
+    }
+    catch (...)
+    {
+      BLE_LOG_WARNING("Failed to retrieve device name");
     }
 
-    // Update stored clients in stored char
-    gattCharacteristicObject->stored_clients = currentClients;
+    auto pendingEvents = deviceNames_.Resolve(deviceId, deviceName);
+    if (!deviceName.has_value())
+      co_return;
+
+    for (const auto &event : pendingEvents)
+    {
+      uiThreadHandler_.Post([deviceId, event, deviceName]
+                            {
+                              bleCallback->OnCharacteristicSubscriptionChange(
+                                  deviceId, event.characteristicId, event.isSubscribed, &deviceName.value(),
+                                  SuccessCallback, ErrorCallback);
+                              // Notify subscription change, now with the device name
+                            });
+    }
   }
 
+
   winrt::fire_and_forget BlePeripheralPlugin::ReadRequestedAsync(GattLocalCharacteristic const &localChar, GattReadRequestedEventArgs args)
   {
     std::string characteristicId = to_uuidstr(localChar.Uuid());
-    std::vector<uint8_t> *value_arg = nullptr;
-    IBuffer charValue = localChar.StaticValue();
-    // IBuffer charValue = nullptr;
-    if (charValue != nullptr)
-    {
-      auto bytevc = to_bytevc(charValue);
-      value_arg = &bytevc;
-    }
-    
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
+    auto currentValue = gattCharacteristicObject == nullptr ? nullptr : std::atomic_load(&gattCharacteristicObject->value);
+
     auto deferral = args.GetDeferral();
     auto request = co_await args.GetRequestAsync();
     if (request == nullptr)
     {
       // No access allowed to the device.  Application should indicate this to the user.
-      std::cout << "No access allowed to the device" << std::endl;
+      BLE_LOG_WARNING("No access allowed to the device");
       deferral.Complete();
       co_return;
     }
 
     std::string deviceId = ParseBluetoothClientId(args.Session().DeviceId().Id());
+    sessions_->Track(deviceId, args.Session());
     int64_t offset = request.Offset();
-  
-    uiThreadHandler_.Post([deviceId, characteristicId, offset, value_arg, deferral, request]
+
+    // Served like the StaticValue it replaces, without a hop to the platform thread
+    if (currentValue != nullptr && !readRequestCallback_.load())
+    {
+      if (static_cast<size_t>(offset) > currentValue->size())
+      {
+        request.RespondWithProtocolError(GattProtocolError::InvalidOffset());
+      }
+      else
+      {
+        size_t length = currentValue->size() - static_cast<size_t>(offset);
+        Buffer buffer(static_cast<uint32_t>(length));
+        if (length > 0)
+          std::memcpy(buffer.data(), currentValue->data() + offset, length);
+        buffer.Length(static_cast<uint32_t>(length));
+        request.RespondWithValue(buffer);
+      }
+      deferral.Complete();
+      co_return;
+    }
+
+    uiThreadHandler_.Post([this, deviceId, characteristicId, offset, currentValue, deferral, request]
                           {
+                            const std::vector<uint8_t> *value_arg = currentValue.get();
+
                             bleCallback->OnReadRequest(
                                 deviceId, characteristicId, offset, value_arg,
                                 // SuccessCallback,
-                                [deferral, request](const ReadRequestResult *readResult)
+                                [this, deferral, request, offset, currentValue](const ReadRequestResult *readResult)
                                 {
                                   if (readResult == nullptr)
                                   {
-                                    std::cout << "ReadRequestResult is null" << std::endl;
-                                    // request.RespondWithProtocolError(GattProtocolError::InvalidHandle());
+                                    BLE_LOG_ERROR("ReadRequestResult is null");
+                                    request.RespondWithProtocolError(GattProtocolError::UnlikelyError());
+                                  }
+                                  else if (readResult->status() != nullptr && *readResult->status() != 0)
+                                  {
+                                    request.RespondWithProtocolError(toGattProtocolError(*readResult->status()));
                                   }
                                   else
                                   {
-                                    // FIXME: use offset as well
-                                    std::vector<uint8_t> resultVal = readResult->value();
-                                    IBuffer result = from_bytevc(resultVal);
-
-                                    // Send response
-                                    DataWriter writer;
-                                    writer.ByteOrder(ByteOrder::LittleEndian);
-                                    writer.WriteBuffer(result);
-                                    request.RespondWithValue(writer.DetachBuffer());
+                                    // The value is sent as returned, like on Android. Only the full value of the characteristic,
+                                    // which the default callback returns, is sliced from the offset of a long read here
+                                    const std::vector<uint8_t> &resultVal = readResult->value();
+                                    size_t start = 0;
+                                    if (offset > 0 && currentValue != nullptr && resultVal == *currentValue)
+                                      start = static_cast<size_t>(offset);
+                                    if (start > resultVal.size())
+                                    {
+                                      request.RespondWithProtocolError(GattProtocolError::InvalidOffset());
+                                    }
+                                    else
+                                    {
+                                      IBuffer result = from_bytevc(std::vector<uint8_t>(resultVal.begin() + start, resultVal.end()));
+
+                                      // Send response
+                                      DataWriter writer;
+                                      writer.ByteOrder(ByteOrder::LittleEndian);
+                                      writer.WriteBuffer(result);
+                                      request.RespondWithValue(writer.DetachBuffer());
+                                    }
                                   }
                                   deferral.Complete();
                                 },
                                 // ErrorCallback
-                                [deferral](const FlutterError &error)
+                                [deferral, request](const FlutterError &error)
                                 {
-                                  std::cout << "ErrorCallback: " << error.message() << std::endl;
+                                  BLE_LOG_ERROR("ErrorCallback: ", error.message());
+                                  request.RespondWithProtocolError(GattProtocolError::UnlikelyError());
                                   deferral.Complete();
                                 });
                             // Handle readRequest result
@@ -575,39 +1479,160 @@ namespace ble_peripheral
     GattWriteRequest request = co_await args.GetRequestAsync();
     if (request == nullptr)
     {
-      std::cout << "No access allowed to the device" << std::endl;
+      BLE_LOG_WARNING("No access allowed to the device");
       deferral.Complete();
       co_return;
     }
 
     std::string deviceId = ParseBluetoothClientId(args.Session().DeviceId().Id());
+    sessions_->Track(deviceId, args.Session());
+    auto characteristicId = guid_to_uuid(localChar.Uuid());
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
+
+    int64_t offset = request.Offset();
+    std::vector<uint8_t> value;
+    if (request.Option() == GattWriteOption::WriteWithResponse)
+    {
+      IBuffer buffer = request.Value();
+      // Prepare Write Request carries at most ATT_MTU - 5 bytes of value
+      std::optional<uint16_t> trackedPduSize = sessions_->MaxPduSize(deviceId);
+      uint16_t maxPduSize = trackedPduSize.has_value() ? *trackedPduSize : args.Session().MaxPduSize();
+      size_t maxFragmentSize = maxPduSize > 5 ? maxPduSize - 5 : 0;
+
+      // Every fragment is answered on its own, the central sends the next one only after that
+      bool ends = true;
+      switch (preparedWrites_.Append(deviceId, characteristicId, request.Offset(), buffer.Length(), maxFragmentSize))
+      {
+      case PreparedWriteQueue::Result::Complete:
+        break;
+      case PreparedWriteQueue::Result::Continues:
+        ends = false;
+        break;
+      case PreparedWriteQueue::Result::InvalidOffset:
+        request.RespondWithProtocolError(GattProtocolError::InvalidOffset());
+        deferral.Complete();
+        co_return;
+      case PreparedWriteQueue::Result::InvalidLength:
+        request.RespondWithProtocolError(GattProtocolError::InvalidAttributeValueLength());
+        deferral.Complete();
+        co_return;
+      }
+
+      RespondToWriteRequest(request, deferral, deviceId, characteristicId, offset, ends, to_bytevc(buffer));
+      co_return;
+    }
+    else
+    {
+      IBuffer buffer = request.Value();
+
+      // writeWithoutResponse has no response to carry an error, invalid packets are dropped
+      auto writePolicy = gattCharacteristicObject == nullptr ? nullptr : std::atomic_load(&gattCharacteristicObject->write_policy);
+      if (writePolicy != nullptr && writePolicy->Validate(offset, buffer.Length()) != WritePolicy::Violation::None)
+      {
+        deferral.Complete();
+        co_return;
+      }
+
+      // Streamed packets never hop to the UI thread one by one
+      auto writeStream = gattCharacteristicObject == nullptr ? nullptr : std::atomic_load(&gattCharacteristicObject->write_stream);
+      if (writeStream != nullptr)
+      {
+        writeStream->Append(deviceId, buffer.data(), buffer.Length());
+        deferral.Complete();
+        co_return;
+      }
+
+      // Copied straight from the request buffer into memory Dart reads in place
+      auto writeRing = std::atomic_load(&writeRing_);
+      if (writeRing != nullptr)
+      {
+        writeRing->Append(deviceId, characteristicId, offset, buffer.data(), buffer.Length());
+        deferral.Complete();
+        co_return;
+      }
+
+      value = to_bytevc(buffer);
+      auto writeBatcher = std::atomic_load(&writeBatcher_);
+      if (writeBatcher != nullptr)
+      {
+        writeBatcher->Append(deviceId, characteristicId, offset, value.data(), value.size());
+        deferral.Complete();
+        co_return;
+      }
+    }
+
+    DispatchWriteRequest(request, deferral, deviceId, characteristicId, offset, std::move(value));
+  }
 
-    uiThreadHandler_.Post([localChar, request, deferral, deviceId]
+  void BlePeripheralPlugin::RespondToWriteRequest(GattWriteRequest request, Deferral deferral, std::string deviceId,
+                                                  std::string characteristicId, int64_t offset, bool ends, std::vector<uint8_t> value)
+  {
+    auto gattCharacteristicObject = FindGattCharacteristicObject(characteristicId);
+    auto writePolicy = gattCharacteristicObject == nullptr ? nullptr : std::atomic_load(&gattCharacteristicObject->write_policy);
+    if (writePolicy != nullptr)
+    {
+      // Common rejections are answered on this thread and never reach Dart
+      switch (writePolicy->Validate(offset, value.size(), ends))
+      {
+      case WritePolicy::Violation::InvalidLength:
+        request.RespondWithProtocolError(GattProtocolError::InvalidAttributeValueLength());
+        deferral.Complete();
+        return;
+      case WritePolicy::Violation::InvalidOffset:
+        request.RespondWithProtocolError(GattProtocolError::InvalidOffset());
+        deferral.Complete();
+        return;
+      case WritePolicy::Violation::None:
+        break;
+      }
+
+      // Acknowledge on this thread and let Dart process the value afterwards
+      if (writePolicy->acknowledgeImmediately)
+      {
+        request.Respond();
+        deferral.Complete();
+        DispatchWriteRequest(nullptr, nullptr, deviceId, characteristicId, offset, std::move(value));
+        return;
+      }
+    }
+    DispatchWriteRequest(request, deferral, deviceId, characteristicId, offset, std::move(value));
+  }
+
+  void BlePeripheralPlugin::DispatchWriteRequest(GattWriteRequest request, Deferral deferral, std::string deviceId,
+                                                 std::string characteristicId, int64_t offset, std::vector<uint8_t> value)
+  {
+    // request and deferral are null if the write was acknowledged natively already,
+    // by an acknowledgeImmediately policy
+    // Batched writeWithoutResponse requests that arrived earlier reach Dart first
+    auto writeBatcher = std::atomic_load(&writeBatcher_);
+    if (writeBatcher != nullptr)
+      writeBatcher->Flush();
+
+    uiThreadHandler_.Post([request, deferral, deviceId, characteristicId, offset, value]() mutable
                           {
-                            auto characteristicId = guid_to_uuid(localChar.Uuid());
-                            int64_t offset = request.Offset();
-                            auto bytevc = to_bytevc(request.Value());
-                            std::vector<uint8_t> *value_arg = &bytevc;
+                            std::vector<uint8_t> *value_arg = &value;
 
                             bleCallback->OnWriteRequest(
                                 deviceId, characteristicId, offset, value_arg,
                                 // SuccessCallback
-                                [deferral, request, localChar](const WriteRequestResult *writeResult)
+                                [this, deferral, request](const WriteRequestResult *writeResult)
                                 {
-                                  // respond with error if status is not null,
-                                  // FIXME: parse proper error
-                                  if (writeResult->status() != nullptr)
-                                    // request.RespondWithProtocolError(GattProtocolError::InvalidHandle());
-                                    std::cout << "WriteRequestResult should throw error" << std::endl;
+                                  if (request == nullptr)
+                                    return;
+                                  if (writeResult != nullptr && writeResult->status() != nullptr && *writeResult->status() != 0)
+                                    request.RespondWithProtocolError(toGattProtocolError(*writeResult->status()));
                                   else
                                     request.Respond();
                                   deferral.Complete();
                                 },
                                 // ErrorCallback
-                                [deferral](const FlutterError &error)
+                                [deferral, request](const FlutterError &error)
                                 {
-                                  std::cout << "ErrorCallback: " << error.message() << std::endl;
-                                  deferral.Complete();
+                                  BLE_LOG_ERROR("ErrorCallback: ", error.message());
+                                  if (request != nullptr)
+                                    request.RespondWithProtocolError(GattProtocolError::UnlikelyError());
+                                  if (deferral != nullptr)
+                                    deferral.Complete();
                                 });
 
                             // Write Request
@@ -619,28 +1644,23 @@ namespace ble_peripheral
     auto serviceId = guid_to_uuid(gattServiceObject->obj.Service().Uuid());
     try
     {
-      // check if serviceMap have this uuid
-      if (serviceProviderMap.find(serviceId) == serviceProviderMap.end())
-      {
-        std::cout << "Service not found in map" << std::endl;
-        return;
-      }
-      std::cout << "Cleaning service: " << serviceId << std::endl;
+      // Callers unpublish the service from serviceRegistry_ first, readers holding a snapshot keep it alive
+      BLE_LOG_DEBUG("Cleaning service: ", serviceId);
       // clean resources for this service
       gattServiceObject->obj.AdvertisementStatusChanged(gattServiceObject->advertisement_status_changed_token);
 
       // Stop advertising if started
-
+      auto status = advertisingStatus_.Untrack(gattServiceObject->obj);
       try
       {
-        if (gattServiceObject->obj.AdvertisementStatus() == GattServiceProviderAdvertisementStatus::Started)
+        if (status == GattServiceProviderAdvertisementStatus::Started)
         {
           gattServiceObject->obj.StopAdvertising();
         }
       }
       catch (...)
       {
-        std::cout << "Warning: Failed to stop advertisement of " << serviceId << std::endl;
+        BLE_LOG_WARNING("Warning: Failed to stop advertisement of ", serviceId);
       }
 
       // clean resources for characteristics
@@ -649,15 +1669,17 @@ namespace ble_peripheral
         gattCharacteristicObject->obj.ReadRequested(gattCharacteristicObject->read_requested_token);
         gattCharacteristicObject->obj.WriteRequested(gattCharacteristicObject->write_requested_token);
         gattCharacteristicObject->obj.SubscribedClientsChanged(gattCharacteristicObject->value_changed_token);
+        if (auto writeStream = std::atomic_exchange(&gattCharacteristicObject->write_stream, std::shared_ptr<WriteStream>()))
+          writeStream->Close();
       }
     }
     catch (const winrt::hresult_error &e)
     {
-      std::wcerr << "Failed to clear service: " << serviceId.c_str() << ", Error: " << e.message().c_str() << std::endl;
+      BLE_LOG_ERROR("Failed to clear service: ", serviceId, ", Error: ", e.message());
     }
     catch (...)
     {
-      std::cout << "Error: Unknown error" << std::endl;
+      BLE_LOG_ERROR("Error: Unknown error");
     }
   }
 
@@ -669,7 +1691,10 @@ namespace ble_peripheral
       return;
     }
     oldRadioState = radioState;
-    bleCallback->OnBleStateChange(radioState == RadioState::On, SuccessCallback, ErrorCallback);
+    // StateChanged is raised on a WinRT thread, callbacks are sent from the platform thread
+    bool isOn = radioState == RadioState::On;
+    uiThreadHandler_.Post([isOn]
+                          { bleCallback->OnBleStateChange(isOn, SuccessCallback, ErrorCallback); });
   }
 
   GattCharacteristicProperties BlePeripheralPlugin::toGattCharacteristicProperties(int property)
@@ -701,6 +1726,49 @@ namespace ble_peripheral
     }
   }
 
+  // Maps the status of Read/WriteRequestResult, the ATT error codes also used by the Android and Darwin
+  // implementations, to a GattProtocolError, unknown codes are reported as UnlikelyError
+  uint8_t BlePeripheralPlugin::toGattProtocolError(int64_t status)
+  {
+    switch (status)
+    {
+    case 1:
+      return GattProtocolError::InvalidHandle();
+    case 2:
+      return GattProtocolError::ReadNotPermitted();
+    case 3:
+      return GattProtocolError::WriteNotPermitted();
+    case 4:
+      return GattProtocolError::InvalidPdu();
+    case 5:
+      return GattProtocolError::InsufficientAuthentication();
+    case 6:
+      return GattProtocolError::RequestNotSupported();
+    case 7:
+      return GattProtocolError::InvalidOffset();
+    case 8:
+      return GattProtocolError::InsufficientAuthorization();
+    case 9:
+      return GattProtocolError::PrepareQueueFull();
+    case 10:
+      return GattProtocolError::AttributeNotFound();
+    case 11:
+      return GattProtocolError::AttributeNotLong();
+    case 12:
+      return GattProtocolError::InsufficientEncryptionKeySize();
+    case 13:
+      return GattProtocolError::InvalidAttributeValueLength();
+    case 15:
+      return GattProtocolError::InsufficientEncryption();
+    case 16:
+      return GattProtocolError::UnsupportedGroupType();
+    case 17:
+      return GattProtocolError::InsufficientResources();
+    default:
+      return GattProtocolError::UnlikelyError();
+    }
+  }
+
   BlePermission BlePeripheralPlugin::toBlePermission(int permission)
   {
     switch (permission)
@@ -777,31 +1845,10 @@ namespace ble_peripheral
     }
   }
 
-  GattCharacteristicObject *BlePeripheralPlugin::FindGattCharacteristicObject(std::string characteristicId)
+  std::shared_ptr<GattCharacteristicObject> BlePeripheralPlugin::FindGattCharacteristicObject(std::string characteristicId)
   {
     // This might return wrong result if multiple services have same characteristic Id
-    std::string loweCaseCharId = to_lower_case(characteristicId);
-    for (auto const &[key, gattServiceObject] : serviceProviderMap)
-    {
-      for (auto const &[charKey, gattChar] : gattServiceObject->characteristics)
-      {
-        if (charKey == loweCaseCharId)
-          return gattChar;
-      }
-    }
-    return nullptr;
-  }
-
-  bool BlePeripheralPlugin::AreAllServicesStarted()
-  {
-    for (auto const &[key, gattServiceObject] : serviceProviderMap)
-    {
-      if (gattServiceObject->obj.AdvertisementStatus() != GattServiceProviderAdvertisementStatus::Started)
-      {
-        return false;
-      }
-    }
-    return true;
+    return serviceRegistry_.FindCharacteristic(to_lower_case(characteristicId));
   }
 
 } // namespace ble_peripheral
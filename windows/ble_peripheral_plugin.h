@@ -13,10 +13,31 @@
 #include <winrt/Windows.Devices.Bluetooth.h>
 #include <winrt/Windows.Devices.Bluetooth.Advertisement.h>
 #include <winrt/Windows.Devices.Bluetooth.GenericAttributeProfile.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "BlePeripheral.g.h"
 #include "Utils.h"
 #include "ui_thread_handler.hpp"
+#include "advertisement_publisher.h"
+#include "advertisement_scheduler.h"
+#include "advertising_status_tracker.h"
+#include "async_window.h"
+#include "callback_dispatcher.h"
+#include "device_name_cache.h"
+#include "gatt_database.h"
+#include "hot_message_codec.h"
+#include "logger.h"
+#include "service_registry.h"
+#include "session_registry.h"
+#include "prepared_write_queue.h"
+#include "write_policy.h"
+#include "write_request_batcher.h"
+#include "write_ring.h"
+#include "write_stream.h"
 
 namespace ble_peripheral
 {
@@ -44,20 +65,59 @@ namespace ble_peripheral
         none = 4,
     };
 
+    // Live GATT objects and the bytes they occupy, lets long running apps verify that
+    // reconfiguring services reaches a steady state
+    struct GattObjectStats
+    {
+        static inline std::atomic<int64_t> services{0};
+        static inline std::atomic<int64_t> characteristics{0};
+        static inline std::atomic<int64_t> bytes{0};
+    };
+
     struct GattCharacteristicObject
     {
+        GattCharacteristicObject();
+        ~GattCharacteristicObject();
+
         GattLocalCharacteristic obj = nullptr;
-        IVectorView<GattSubscribedClient> stored_clients;
+        // Subscribed clients by device id, guarded by subscribers_mutex
+        std::unordered_map<std::string, GattSubscribedClient> subscribers;
+        std::mutex subscribers_mutex;
         winrt::event_token value_changed_token;
         winrt::event_token read_requested_token;
         winrt::event_token write_requested_token;
+        // Accessed with std::atomic_load/atomic_store, WriteRequested runs on WinRT threads
+        std::shared_ptr<WriteStream> write_stream;
+        std::shared_ptr<const WritePolicy> write_policy;
+        // Value served to reads, kept here as StaticValue can not change once the characteristic exists.
+        // Reads are answered from it natively while Dart has no readRequest callback.
+        // Accessed with std::atomic_load/atomic_store, ReadRequested runs on WinRT threads
+        std::shared_ptr<const std::vector<uint8_t>> value;
     };
 
+    // Time spent in each step of BlePeripheralPlugin::BuildServiceAsync
+    struct ServiceBuildTimings
+    {
+        std::chrono::microseconds provider{0};
+        std::chrono::microseconds characteristics{0};
+        std::chrono::microseconds descriptors{0};
+        std::chrono::microseconds total{0};
+    };
+
+    // Owned by the versions of ServiceRegistry, handlers keep a service alive through the shared_ptr of any of its characteristics
     struct GattServiceProviderObject
     {
+        GattServiceProviderObject();
+        ~GattServiceProviderObject();
+
         GattServiceProvider obj = nullptr;
         winrt::event_token advertisement_status_changed_token;
+        // Slab holding every characteristic of the service, a deque never moves its elements
+        std::deque<GattCharacteristicObject> characteristic_slab;
+        // Points into characteristic_slab
         std::map<std::string, GattCharacteristicObject *> characteristics;
+        // GattServiceLayout of the service this provider was built from
+        std::string layout;
     };
 
     class BlePeripheralPlugin : public flutter::Plugin, public BlePeripheralChannel
@@ -72,22 +132,57 @@ namespace ble_peripheral
         static void SuccessCallback() {}
         static void ErrorCallback(const FlutterError &error)
         {
-            std::cout << "ErrorCallback: " << error.message() << std::endl;
+            BLE_LOG_ERROR("ErrorCallback: ", error.message());
         }
 
         // Disallow copy and assign.
         BlePeripheralPlugin(const BlePeripheralPlugin &) = delete;
         BlePeripheralPlugin &operator=(const BlePeripheralPlugin &) = delete;
 
+        // Registered plugin the exported C functions of ble_peripheral_ffi.h talk to, null before registration
+        static BlePeripheralPlugin *Instance() { return instance_.load(); }
+
+        enum class NotifyResult
+        {
+            Sent,
+            CharacteristicNotFound,
+            DeviceNotSubscribed,
+            ValueExceedsMtu,
+        };
+        // Notifies every subscriber, or only deviceId when given, safe to call from any thread
+        NotifyResult NotifyValue(const std::string &characteristicId, const uint8_t *value, size_t length,
+                                 const std::string *deviceId);
+        // Error reported to Dart for a NotifyValue result, nullopt once sent
+        std::optional<FlutterError> NotifyError(NotifyResult result, const std::string *deviceId);
+        // writeWithoutResponse requests go to the ring instead of Dart callbacks until it is stopped,
+        // a new ring replaces the previous one
+        void StartWriteRing(std::shared_ptr<WriteRing> writeRing);
+        void StopWriteRing();
+
         BlePeripheralUiThreadHandler uiThreadHandler_;
 
         // BluetoothLe
         Radio bluetoothRadio{nullptr};
 
         winrt::fire_and_forget InitializeAdapter();
-        winrt::fire_and_forget AddServiceAsync(const BleService &service);
+        winrt::fire_and_forget AddServiceAsync(BleService service);
+        // Resolves to an empty string once the service is registered in serviceRegistry_, else to the error
+        IAsyncOperation<hstring> BuildServiceAsync(BleService service);
+        static constexpr size_t kMaxInFlightCreations = 4;
+        winrt::fire_and_forget AddServicesAsync(std::vector<BleService> services,
+                                                std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        static constexpr size_t kMaxInFlightServices = 4;
+        winrt::fire_and_forget LoadGattDatabaseAsync(std::string path, bool incremental,
+                                                     std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        // Reports a file or schema error to result and returns nullopt if the database is not valid
+        std::optional<std::vector<BleService>> ReadGattDatabase(const std::string &path,
+                                                                const std::function<void(ErrorOr<flutter::EncodableMap> reply)> &result);
+        // Runs on the platform thread, rebuilds only services whose layout changed
+        void ApplyServices(std::vector<BleService> services,
+                           std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
         GattCharacteristicProperties toGattCharacteristicProperties(int property);
         BlePermission toBlePermission(int permission);
+        uint8_t toGattProtocolError(int64_t status);
         std::string AdvertisementStatusToString(GattServiceProviderAdvertisementStatus status);
         void disposeGattServiceObject(GattServiceProviderObject *gattServiceObject);
         void Radio_StateChanged(Radio radio, IInspectable args);
@@ -95,35 +190,108 @@ namespace ble_peripheral
         winrt::event_revoker<IRadio> radioStateChangedRevoker;
         std::string ParseBluetoothClientId(hstring clientId);
 
-        GattCharacteristicObject *FindGattCharacteristicObject(std::string characteristicId);
+        // Added services, read from WinRT handler threads without locking
+        ServiceRegistry<GattServiceProviderObject, GattCharacteristicObject> serviceRegistry_;
+        // Answers whether services advertise without asking every provider
+        AdvertisingStatusTracker advertisingStatus_;
+        // Shares ownership of the service the characteristic belongs to
+        std::shared_ptr<GattCharacteristicObject> FindGattCharacteristicObject(std::string characteristicId);
 
         void ServiceProvider_AdvertisementStatusChanged(GattServiceProvider const &sender, GattServiceProviderAdvertisementStatusChangedEventArgs const &);
-        winrt::fire_and_forget SubscribedClientsChanged(GattLocalCharacteristic const &sender, IInspectable const &);
+        void SubscribedClientsChanged(GattLocalCharacteristic const &sender, IInspectable const &);
+        void NotifySubscriptionChange(GattSession session, std::string deviceId, std::string characteristicId, bool isSubscribed);
+        winrt::fire_and_forget ResolveDeviceName(hstring bluetoothDeviceId, std::string deviceId);
+        DeviceNameCache deviceNames_;
+        std::unique_ptr<SessionRegistry> sessions_;
+        // Local name and manufacturer data, next to the advertisements of the services
+        std::shared_ptr<AdvertisementPublisher> advertisementPublisher_;
+        // Resolved by InitializeAdapter, false on Windows versions without BluetoothAdapter::IsExtendedAdvertisingSupported
+        std::atomic<bool> extendedAdvertisingSupported_{false};
+        // Start and stop transactions run on background threads, one at a time
+        std::mutex advertisingMutex_;
+        winrt::fire_and_forget StartAdvertisingAsync(AdvertisementPublisher::Config publisherConfig,
+                                                     std::optional<int64_t> timeoutMs,
+                                                     std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        winrt::fire_and_forget StopAdvertisingAsync(std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        // Stops the publisher and every service, returns the error of every service that failed to stop
+        flutter::EncodableMap StopAdvertisingServices();
+        // Set while a rotation runs, replaces the publisher and the service advertisements.
+        // Swapped with std::atomic_exchange, the platform thread only loads it
+        std::shared_ptr<AdvertisementScheduler> advertisementScheduler_;
+        winrt::fire_and_forget StartAdvertisementRotationAsync(std::vector<AdvertisementScheduler::Set> sets,
+                                                               std::function<void(std::optional<FlutterError> reply)> result);
+        winrt::fire_and_forget StopAdvertisementRotationAsync(std::function<void(std::optional<FlutterError> reply)> result);
+        // Takes the rotation off air and joins its thread, off the platform thread and without advertisingMutex_,
+        // which the scheduler thread takes to switch the services off
+        void StopAdvertisementScheduler();
+        // Called from the scheduler thread for the slots of connectable sets, under advertisingMutex_
+        void SetServicesAdvertising(bool advertise);
         winrt::fire_and_forget ReadRequestedAsync(GattLocalCharacteristic const &, GattReadRequestedEventArgs args);
+        // Set while Dart has a readRequest callback, reads of characteristics with a value reach Dart only then
+        std::atomic<bool> readRequestCallback_{false};
         winrt::fire_and_forget WriteRequestedAsync(GattLocalCharacteristic const &, GattWriteRequestedEventArgs args);
+        // Applies the write policy of the characteristic to a writeWithResponse request, then hands it to Dart.
+        // ends is false for a prepared write fragment that may still be continued
+        void RespondToWriteRequest(GattWriteRequest request, Deferral deferral, std::string deviceId,
+                                   std::string characteristicId, int64_t offset, bool ends, std::vector<uint8_t> value);
+        void DispatchWriteRequest(GattWriteRequest request, Deferral deferral, std::string deviceId,
+                                  std::string characteristicId, int64_t offset, std::vector<uint8_t> value);
+        PreparedWriteQueue preparedWrites_;
+        // Accessed with std::atomic_load/store, WinRT threads append while Dart replaces it
+        std::shared_ptr<WriteRequestBatcher> writeBatcher_;
+        // Accessed with std::atomic_load/store, takes precedence over writeBatcher_
+        std::shared_ptr<WriteRing> writeRing_;
         std::string ParseBluetoothError(BluetoothError error);
-        bool AreAllServicesStarted();
 
         // BlePeripheralChannel
         std::optional<FlutterError> Initialize();
         ErrorOr<std::optional<bool>> IsAdvertising();
         ErrorOr<bool> IsSupported();
-        std::optional<FlutterError> StopAdvertising();
+        void StopAdvertising(std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
         ErrorOr<bool> AskBlePermission();
         std::optional<FlutterError> AddService(const BleService &service);
         std::optional<FlutterError> RemoveService(const std::string &service_id);
         std::optional<FlutterError> ClearServices();
         ErrorOr<flutter::EncodableList> GetServices();
-        std::optional<FlutterError> StartAdvertising(
+        void StartAdvertising(
             const flutter::EncodableList &services,
             const std::string *local_name,
             const int64_t *timeout,
             const ManufacturerData *manufacturer_data,
-            bool add_manufacturer_data_in_scan_response);
+            bool add_manufacturer_data_in_scan_response,
+            std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
         std::optional<FlutterError> UpdateCharacteristic(
             const std::string &characteristic_id,
             const std::vector<uint8_t> &value,
             const std::string *device_id);
+        std::optional<FlutterError> SetWriteStreamConfig(
+            const std::string &characteristic_id,
+            const WriteStreamConfig *config);
+        std::optional<FlutterError> SetCharacteristicWritePolicy(
+            const std::string &characteristic_id,
+            const CharacteristicWritePolicy *policy);
+        std::optional<FlutterError> SetWriteBatchPolicy(const WriteBatchPolicy *policy);
+        void AddServices(
+            const flutter::EncodableList &services,
+            std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        void LoadGattDatabase(
+            const std::string &path,
+            std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        void ApplyGattDatabase(
+            const std::string &path,
+            std::function<void(ErrorOr<flutter::EncodableMap> reply)> result);
+        ErrorOr<flutter::EncodableMap> GetNativeStats();
+        void StartAdvertisementRotation(
+            const flutter::EncodableList &sets,
+            std::function<void(std::optional<FlutterError> reply)> result);
+        void StopAdvertisementRotation(std::function<void(std::optional<FlutterError> reply)> result);
+        ErrorOr<flutter::EncodableList> GetAdvertisementRotationStats();
+        std::optional<FlutterError> UpdateAdvertisingData(
+            const std::string *local_name,
+            const ManufacturerData *manufacturer_data);
+
+    private:
+        static std::atomic<BlePeripheralPlugin *> instance_;
     };
 
 } // namespace ble_peripheral
@@ -0,0 +1,406 @@
+#include "callback_dispatcher.h"
+
+#include <flutter/byte_streams.h>
+
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace ble_peripheral
+{
+  using flutter::CustomEncodableValue;
+  using flutter::EncodableList;
+  using flutter::EncodableValue;
+
+  namespace
+  {
+    constexpr const char *kChannelPrefix = "dev.flutter.pigeon.ble_peripheral.BleCallback.";
+
+    // Appends to a buffer that keeps its capacity between messages
+    class ScratchWriter : public flutter::ByteStreamWriter
+    {
+    public:
+      explicit ScratchWriter(std::vector<uint8_t> &buffer) : buffer_(buffer) {}
+
+      void WriteByte(uint8_t byte) override { buffer_.push_back(byte); }
+
+      void WriteBytes(const uint8_t *bytes, size_t length) override
+      {
+        buffer_.insert(buffer_.end(), bytes, bytes + length);
+      }
+
+      void WriteAlignment(uint8_t alignment) override
+      {
+        while (buffer_.size() % alignment != 0)
+          buffer_.push_back(0);
+      }
+
+    private:
+      std::vector<uint8_t> &buffer_;
+    };
+
+    // Reads a reply where the engine delivered it, without copying it first
+    class SpanReader : public flutter::ByteStreamReader
+    {
+    public:
+      SpanReader(const uint8_t *bytes, size_t size) : bytes_(bytes), size_(size) {}
+
+      uint8_t ReadByte() override
+      {
+        if (position_ >= size_)
+          throw std::out_of_range("Reply is truncated");
+        return bytes_[position_++];
+      }
+
+      void ReadBytes(uint8_t *buffer, size_t length) override
+      {
+        if (length > size_ - position_)
+          throw std::out_of_range("Reply is truncated");
+        std::memcpy(buffer, bytes_ + position_, length);
+        position_ += length;
+      }
+
+      void ReadAlignment(uint8_t alignment) override
+      {
+        size_t mod = position_ % alignment;
+        if (mod != 0)
+          position_ += alignment - mod;
+      }
+
+    private:
+      const uint8_t *bytes_;
+      size_t size_;
+      size_t position_ = 0;
+    };
+
+    int64_t NanosSince(std::chrono::steady_clock::time_point start)
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    FlutterError ConnectionError(const std::string &channel_name)
+    {
+      return FlutterError(
+          "channel-error",
+          "Unable to establish connection on channel: '" + channel_name + "'.",
+          EncodableValue(""));
+    }
+
+    std::function<void(const EncodableValue &)> IgnoreResult(std::function<void(void)> &&on_success)
+    {
+      return [on_success = std::move(on_success)](const EncodableValue &)
+      { on_success(); };
+    }
+  } // namespace
+
+  BleCallbackDispatcher::BleCallbackDispatcher(flutter::BinaryMessenger *binary_messenger,
+                                               const std::string &message_channel_suffix)
+      : binary_messenger_(binary_messenger)
+  {
+    const std::string suffix = message_channel_suffix.empty() ? "" : "." + message_channel_suffix;
+    const char *names[kChannelCount] = {
+        "onCharacteristicSubscriptionChange",
+        "onAdvertisingStatusUpdate",
+        "onBleStateChange",
+        "onServiceAdded",
+        "onMtuChange",
+        "onConnectionStateChange",
+        "onBondStateChange",
+        "onWriteStream",
+        "onWriteRequestsBatch",
+    };
+    for (size_t i = 0; i < kChannelCount; ++i)
+      channel_names_[i] = kChannelPrefix + std::string(names[i]) + suffix;
+    binary_channel_names_[kBinaryReadRequest] = hot_message::kReadRequestChannel + suffix;
+    binary_channel_names_[kBinaryWriteRequest] = hot_message::kWriteRequestChannel + suffix;
+  }
+
+  BleCallbackDispatcher::Stats BleCallbackDispatcher::stats() const
+  {
+    Stats stats;
+    stats.sent = sent_.load();
+    stats.sendNanos = send_nanos_.load();
+    stats.replies = replies_.load();
+    stats.replyNanos = reply_nanos_.load();
+    stats.binarySent = binary_sent_.load();
+    stats.binarySendNanos = binary_send_nanos_.load();
+    stats.binaryReplies = binary_replies_.load();
+    stats.binaryReplyNanos = binary_reply_nanos_.load();
+    return stats;
+  }
+
+  void BleCallbackDispatcher::Send(Channel channel,
+                                   const EncodableValue &arguments,
+                                   std::function<void(const EncodableValue &result)> &&on_result,
+                                   std::function<void(const FlutterError &)> &&on_error)
+  {
+    auto start = std::chrono::steady_clock::now();
+    const std::string *channel_name = &channel_names_[channel];
+
+    scratch_.clear();
+    ScratchWriter writer(scratch_);
+    PigeonInternalCodecSerializer::GetInstance().WriteValue(arguments, &writer);
+
+    // The engine copies the message before Send returns, scratch_ is free again afterwards
+    binary_messenger_->Send(
+        *channel_name, scratch_.data(), scratch_.size(),
+        [this, channel_name, on_result = std::move(on_result), on_error = std::move(on_error)](const uint8_t *reply, size_t reply_size)
+        {
+          auto replyStart = std::chrono::steady_clock::now();
+          if (reply == nullptr || reply_size == 0)
+          {
+            on_error(ConnectionError(*channel_name));
+            return;
+          }
+
+          EncodableValue response;
+          try
+          {
+            SpanReader reader(reply, reply_size);
+            response = PigeonInternalCodecSerializer::GetInstance().ReadValue(&reader);
+          }
+          catch (const std::exception &)
+          {
+            on_error(ConnectionError(*channel_name));
+            return;
+          }
+
+          // Void callbacks reply with an empty list
+          const auto *list_return_value = std::get_if<EncodableList>(&response);
+          if (list_return_value == nullptr)
+            on_error(ConnectionError(*channel_name));
+          else if (list_return_value->size() > 1)
+            on_error(FlutterError(std::get<std::string>(list_return_value->at(0)), std::get<std::string>(list_return_value->at(1)), list_return_value->at(2)));
+          else if (list_return_value->empty())
+            on_result(EncodableValue());
+          else
+            on_result(list_return_value->at(0));
+
+          replies_++;
+          reply_nanos_ += NanosSince(replyStart);
+        });
+
+    sent_++;
+    send_nanos_ += NanosSince(start);
+  }
+
+  void BleCallbackDispatcher::SendAttributeRequest(
+      BinaryChannel channel,
+      const std::string &device_id,
+      const std::string &characteristic_id,
+      int64_t offset,
+      const std::vector<uint8_t> *value,
+      std::function<void(const hot_message::AttributeResultView &result)> &&on_result,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    auto start = std::chrono::steady_clock::now();
+    const std::string *channel_name = &binary_channel_names_[channel];
+
+    hot_message::EncodeAttributeRequest(scratch_, device_id, characteristic_id, offset, value);
+    binary_messenger_->Send(
+        *channel_name, scratch_.data(), scratch_.size(),
+        [this, channel_name, on_result = std::move(on_result), on_error = std::move(on_error)](const uint8_t *reply, size_t reply_size)
+        {
+          auto replyStart = std::chrono::steady_clock::now();
+          hot_message::AttributeResultView result;
+          if (!hot_message::DecodeAttributeResult(reply, reply_size, result))
+          {
+            on_error(ConnectionError(*channel_name));
+            return;
+          }
+
+          if (result.flags & hot_message::kError)
+            on_error(FlutterError("error", std::string(reinterpret_cast<const char *>(result.value), result.valueLength)));
+          else
+            on_result(result);
+
+          binary_replies_++;
+          binary_reply_nanos_ += NanosSince(replyStart);
+        });
+
+    binary_sent_++;
+    binary_send_nanos_ += NanosSince(start);
+  }
+
+  void BleCallbackDispatcher::OnReadRequest(
+      const std::string &device_id,
+      const std::string &characteristic_id,
+      int64_t offset,
+      const std::vector<uint8_t> *value,
+      std::function<void(const ReadRequestResult *)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    SendAttributeRequest(
+        kBinaryReadRequest, device_id, characteristic_id, offset, value,
+        [on_success = std::move(on_success)](const hot_message::AttributeResultView &result)
+        {
+          if (result.flags & hot_message::kNullResult)
+          {
+            on_success(nullptr);
+            return;
+          }
+          ReadRequestResult readResult(
+              std::vector<uint8_t>(result.value, result.value + result.valueLength),
+              (result.flags & hot_message::kHasOffset) ? &result.offset : nullptr,
+              (result.flags & hot_message::kHasStatus) ? &result.status : nullptr);
+          on_success(&readResult);
+        },
+        std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnWriteRequest(
+      const std::string &device_id,
+      const std::string &characteristic_id,
+      int64_t offset,
+      const std::vector<uint8_t> *value,
+      std::function<void(const WriteRequestResult *)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    SendAttributeRequest(
+        kBinaryWriteRequest, device_id, characteristic_id, offset, value,
+        [on_success = std::move(on_success)](const hot_message::AttributeResultView &result)
+        {
+          if (result.flags & hot_message::kNullResult)
+          {
+            on_success(nullptr);
+            return;
+          }
+          std::optional<std::vector<uint8_t>> resultValue;
+          if (result.flags & hot_message::kHasValue)
+            resultValue.emplace(result.value, result.value + result.valueLength);
+          WriteRequestResult writeResult(
+              resultValue.has_value() ? &resultValue.value() : nullptr,
+              (result.flags & hot_message::kHasOffset) ? &result.offset : nullptr,
+              (result.flags & hot_message::kHasStatus) ? &result.status : nullptr);
+          on_success(&writeResult);
+        },
+        std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnCharacteristicSubscriptionChange(
+      const std::string &device_id,
+      const std::string &characteristic_id,
+      bool is_subscribed,
+      const std::string *name,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kCharacteristicSubscriptionChange,
+         EncodableValue(EncodableList{
+             EncodableValue(device_id),
+             EncodableValue(characteristic_id),
+             EncodableValue(is_subscribed),
+             name ? EncodableValue(*name) : EncodableValue(),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnAdvertisingStatusUpdate(
+      bool advertising,
+      const std::string *error,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kAdvertisingStatusUpdate,
+         EncodableValue(EncodableList{
+             EncodableValue(advertising),
+             error ? EncodableValue(*error) : EncodableValue(),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnBleStateChange(
+      bool state,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kBleStateChange,
+         EncodableValue(EncodableList{
+             EncodableValue(state),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnServiceAdded(
+      const std::string &service_id,
+      const std::string *error,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kServiceAdded,
+         EncodableValue(EncodableList{
+             EncodableValue(service_id),
+             error ? EncodableValue(*error) : EncodableValue(),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnMtuChange(
+      const std::string &device_id,
+      int64_t mtu,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kMtuChange,
+         EncodableValue(EncodableList{
+             EncodableValue(device_id),
+             EncodableValue(mtu),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnConnectionStateChange(
+      const std::string &device_id,
+      bool connected,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kConnectionStateChange,
+         EncodableValue(EncodableList{
+             EncodableValue(device_id),
+             EncodableValue(connected),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnBondStateChange(
+      const std::string &device_id,
+      const BondState &bond_state,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kBondStateChange,
+         EncodableValue(EncodableList{
+             EncodableValue(device_id),
+             CustomEncodableValue(bond_state),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnWriteStream(
+      const WriteStreamBatch &batch,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kWriteStream,
+         EncodableValue(EncodableList{
+             CustomEncodableValue(batch),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+  void BleCallbackDispatcher::OnWriteRequestsBatch(
+      const WriteRequestBatch &batch,
+      std::function<void(void)> &&on_success,
+      std::function<void(const FlutterError &)> &&on_error)
+  {
+    Send(kWriteRequestsBatch,
+         EncodableValue(EncodableList{
+             CustomEncodableValue(batch),
+         }),
+         IgnoreResult(std::move(on_success)), std::move(on_error));
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <flutter/binary_messenger.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BlePeripheral.g.h"
+#include "hot_message_codec.h"
+
+namespace ble_peripheral
+{
+
+    /// Drop-in replacement for the generated BleCallback that sends through channels resolved once.
+    /// Channel names are built in the constructor, arguments are encoded into one reused scratch buffer
+    /// and replies are decoded in place instead of into a heap allocated EncodableValue.
+    /// Read and write requests skip the standard codec, they use the fixed layout of hot_message_codec.h.
+    /// Must be used from the platform thread, like BleCallback
+    class BleCallbackDispatcher
+    {
+    public:
+        // Accumulated cost of the callbacks sent so far, to compare against the generated BleCallback
+        struct Stats
+        {
+            int64_t sent = 0;
+            int64_t sendNanos = 0;
+            int64_t replies = 0;
+            int64_t replyNanos = 0;
+            // Read and write requests, counted apart to compare them against the codec path
+            int64_t binarySent = 0;
+            int64_t binarySendNanos = 0;
+            int64_t binaryReplies = 0;
+            int64_t binaryReplyNanos = 0;
+        };
+
+        explicit BleCallbackDispatcher(flutter::BinaryMessenger *binary_messenger,
+                                       const std::string &message_channel_suffix = "");
+
+        BleCallbackDispatcher(const BleCallbackDispatcher &) = delete;
+        BleCallbackDispatcher &operator=(const BleCallbackDispatcher &) = delete;
+
+        void OnReadRequest(
+            const std::string &device_id,
+            const std::string &characteristic_id,
+            int64_t offset,
+            const std::vector<uint8_t> *value,
+            std::function<void(const ReadRequestResult *)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnWriteRequest(
+            const std::string &device_id,
+            const std::string &characteristic_id,
+            int64_t offset,
+            const std::vector<uint8_t> *value,
+            std::function<void(const WriteRequestResult *)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnCharacteristicSubscriptionChange(
+            const std::string &device_id,
+            const std::string &characteristic_id,
+            bool is_subscribed,
+            const std::string *name,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnAdvertisingStatusUpdate(
+            bool advertising,
+            const std::string *error,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnBleStateChange(
+            bool state,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnServiceAdded(
+            const std::string &service_id,
+            const std::string *error,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnMtuChange(
+            const std::string &device_id,
+            int64_t mtu,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnConnectionStateChange(
+            const std::string &device_id,
+            bool connected,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnBondStateChange(
+            const std::string &device_id,
+            const BondState &bond_state,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnWriteStream(
+            const WriteStreamBatch &batch,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+        void OnWriteRequestsBatch(
+            const WriteRequestBatch &batch,
+            std::function<void(void)> &&on_success,
+            std::function<void(const FlutterError &)> &&on_error);
+
+        Stats stats() const;
+
+    private:
+        enum Channel : size_t
+        {
+            kCharacteristicSubscriptionChange,
+            kAdvertisingStatusUpdate,
+            kBleStateChange,
+            kServiceAdded,
+            kMtuChange,
+            kConnectionStateChange,
+            kBondStateChange,
+            kWriteStream,
+            kWriteRequestsBatch,
+            kChannelCount,
+        };
+
+        enum BinaryChannel : size_t
+        {
+            kBinaryReadRequest,
+            kBinaryWriteRequest,
+            kBinaryChannelCount,
+        };
+
+        // on_result receives the first element of a successful reply
+        void Send(Channel channel,
+                  const flutter::EncodableValue &arguments,
+                  std::function<void(const flutter::EncodableValue &result)> &&on_result,
+                  std::function<void(const FlutterError &)> &&on_error);
+
+        // on_result receives the decoded reply unless it is an error
+        void SendAttributeRequest(BinaryChannel channel,
+                                  const std::string &device_id,
+                                  const std::string &characteristic_id,
+                                  int64_t offset,
+                                  const std::vector<uint8_t> *value,
+                                  std::function<void(const hot_message::AttributeResultView &result)> &&on_result,
+                                  std::function<void(const FlutterError &)> &&on_error);
+
+        flutter::BinaryMessenger *binary_messenger_;
+        std::array<std::string, kChannelCount> channel_names_;
+        std::array<std::string, kBinaryChannelCount> binary_channel_names_;
+        std::vector<uint8_t> scratch_;
+
+        std::atomic<int64_t> sent_{0};
+        std::atomic<int64_t> send_nanos_{0};
+        std::atomic<int64_t> replies_{0};
+        std::atomic<int64_t> reply_nanos_{0};
+        std::atomic<int64_t> binary_sent_{0};
+        std::atomic<int64_t> binary_send_nanos_{0};
+        std::atomic<int64_t> binary_replies_{0};
+        std::atomic<int64_t> binary_reply_nanos_{0};
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,72 @@
+#include "device_name_cache.h"
+
+namespace ble_peripheral
+{
+
+  DeviceNameCache::DeviceNameCache(size_t capacity) : capacity_(capacity) {}
+
+  std::optional<std::string> DeviceNameCache::Get(const std::string &deviceId)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(deviceId);
+    if (it == index_.end())
+      return std::nullopt;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  bool DeviceNameCache::AddPending(const std::string &deviceId, PendingEvent event)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = pending_.try_emplace(deviceId);
+    it->second.push_back(std::move(event));
+    return inserted;
+  }
+
+  std::vector<DeviceNameCache::PendingEvent> DeviceNameCache::Resolve(const std::string &deviceId,
+                                                                      const std::optional<std::string> &name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(deviceId);
+    // Invalidated while the lookup was running
+    if (it == pending_.end())
+      return {};
+
+    std::vector<PendingEvent> events = std::move(it->second);
+    pending_.erase(it);
+    if (name.has_value())
+      Put(deviceId, *name);
+    return events;
+  }
+
+  void DeviceNameCache::Invalidate(const std::string &deviceId)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(deviceId);
+    auto it = index_.find(deviceId);
+    if (it == index_.end())
+      return;
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  void DeviceNameCache::Put(const std::string &deviceId, const std::string &name)
+  {
+    auto it = index_.find(deviceId);
+    if (it != index_.end())
+    {
+      it->second->second = name;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+
+    entries_.emplace_front(deviceId, name);
+    index_.emplace(deviceId, entries_.begin());
+    if (entries_.size() > capacity_)
+    {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+} // namespace ble_peripheral
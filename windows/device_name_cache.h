@@ -0,0 +1,55 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ble_peripheral
+{
+
+    /// Bounded LRU cache of device id to device name, shared by all characteristics.
+    /// A name is looked up once per device, subscription events arriving meanwhile wait for it in pending
+    class DeviceNameCache
+    {
+    public:
+        struct PendingEvent
+        {
+            std::string characteristicId;
+            bool isSubscribed;
+        };
+
+        explicit DeviceNameCache(size_t capacity = 64);
+
+        DeviceNameCache(const DeviceNameCache &) = delete;
+        DeviceNameCache &operator=(const DeviceNameCache &) = delete;
+
+        std::optional<std::string> Get(const std::string &deviceId);
+
+        // Queues an event waiting for the name of deviceId,
+        // returns true if no lookup is running yet and the caller has to start one
+        bool AddPending(const std::string &deviceId, PendingEvent event);
+
+        // Completes a lookup, caches a found name and returns the events waiting for it
+        std::vector<PendingEvent> Resolve(const std::string &deviceId, const std::optional<std::string> &name);
+
+        // Drops the cached name and discards the result of a running lookup
+        void Invalidate(const std::string &deviceId);
+
+    private:
+        using Entry = std::pair<std::string, std::string>;
+
+        void Put(const std::string &deviceId, const std::string &name);
+
+        std::mutex mutex_;
+        size_t capacity_;
+        // Most recently used first
+        std::list<Entry> entries_;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+        std::unordered_map<std::string, std::vector<PendingEvent>> pending_;
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,313 @@
+#include "gatt_database.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <set>
+#include <sstream>
+
+#include <winrt/Windows.Data.Json.h>
+
+#include "Utils.h"
+
+namespace ble_peripheral
+{
+  using winrt::Windows::Data::Json::IJsonValue;
+  using winrt::Windows::Data::Json::JsonArray;
+  using winrt::Windows::Data::Json::JsonObject;
+  using winrt::Windows::Data::Json::JsonValueType;
+
+  namespace
+  {
+    // Index of each name is the value of the Dart enum, see lib/src/models/ble_enums.dart
+    const std::vector<std::string> kCharacteristicProperties = {
+        "broadcast",
+        "read",
+        "writeWithoutResponse",
+        "write",
+        "notify",
+        "indicate",
+        "authenticatedSignedWrites",
+        "extendedProperties",
+        "notifyEncryptionRequired",
+        "indicateEncryptionRequired",
+    };
+
+    const std::vector<std::string> kAttributePermissions = {
+        "readable",
+        "writeable",
+        "readEncryptionRequired",
+        "writeEncryptionRequired",
+    };
+
+    // Collects every error of a pass instead of stopping at the first one
+    class Validator
+    {
+    public:
+      std::vector<std::string> errors;
+
+      void Error(const std::string &path, const std::string &message)
+      {
+        errors.push_back(path + ": " + message);
+      }
+
+      std::optional<std::string> String(const JsonObject &object, const std::string &path, const wchar_t *key, bool required)
+      {
+        if (!object.HasKey(key))
+        {
+          if (required)
+            Error(path, "missing " + winrt::to_string(key));
+          return std::nullopt;
+        }
+        IJsonValue value = object.GetNamedValue(key);
+        if (value.ValueType() != JsonValueType::String)
+        {
+          Error(path + "." + winrt::to_string(key), "expected a string");
+          return std::nullopt;
+        }
+        return winrt::to_string(value.GetString());
+      }
+
+      std::optional<JsonArray> Array(const JsonObject &object, const std::string &path, const wchar_t *key, bool required)
+      {
+        if (!object.HasKey(key))
+        {
+          if (required)
+            Error(path, "missing " + winrt::to_string(key));
+          return std::nullopt;
+        }
+        IJsonValue value = object.GetNamedValue(key);
+        if (value.ValueType() != JsonValueType::Array)
+        {
+          Error(path + "." + winrt::to_string(key), "expected an array");
+          return std::nullopt;
+        }
+        return value.GetArray();
+      }
+
+      std::optional<std::string> Uuid(const JsonObject &object, const std::string &path)
+      {
+        auto uuid = String(object, path, L"uuid", true);
+        if (!uuid.has_value())
+          return std::nullopt;
+
+        std::string lower = to_lower_case(*uuid);
+        auto isHex = [](const std::string &text)
+        {
+          return std::all_of(text.begin(), text.end(), [](unsigned char c)
+                             { return std::isxdigit(c) != 0; });
+        };
+        if (lower.size() == 4 && isHex(lower))
+          return "0000" + lower + "-0000-1000-8000-00805f9b34fb";
+
+        bool valid = lower.size() == 36;
+        for (size_t i = 0; valid && i < lower.size(); ++i)
+        {
+          bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+          valid = dash ? lower[i] == '-' : std::isxdigit(static_cast<unsigned char>(lower[i])) != 0;
+        }
+        if (!valid)
+        {
+          Error(path + ".uuid", "invalid uuid '" + *uuid + "'");
+          return std::nullopt;
+        }
+        return lower;
+      }
+
+      flutter::EncodableList Enums(const JsonArray &names, const std::string &path, const std::vector<std::string> &known)
+      {
+        flutter::EncodableList indices;
+        for (uint32_t i = 0; i < names.Size(); ++i)
+        {
+          std::string itemPath = path + "[" + std::to_string(i) + "]";
+          IJsonValue value = names.GetAt(i);
+          if (value.ValueType() != JsonValueType::String)
+          {
+            Error(itemPath, "expected a string");
+            continue;
+          }
+          std::string name = winrt::to_string(value.GetString());
+          auto it = std::find(known.begin(), known.end(), name);
+          if (it == known.end())
+          {
+            Error(itemPath, "unknown value '" + name + "'");
+            continue;
+          }
+          indices.push_back(flutter::EncodableValue(static_cast<int64_t>(it - known.begin())));
+        }
+        return indices;
+      }
+
+      std::optional<std::vector<uint8_t>> Value(const JsonObject &object, const std::string &path)
+      {
+        auto hex = String(object, path, L"value", false);
+        if (!hex.has_value())
+          return std::nullopt;
+
+        auto isHex = [](char c)
+        { return std::isxdigit(static_cast<unsigned char>(c)) != 0; };
+        if (hex->size() % 2 != 0 || !std::all_of(hex->begin(), hex->end(), isHex))
+        {
+          Error(path + ".value", "expected an even number of hex digits");
+          return std::nullopt;
+        }
+        std::vector<uint8_t> bytes;
+        bytes.reserve(hex->size() / 2);
+        for (size_t i = 0; i < hex->size(); i += 2)
+          bytes.push_back(static_cast<uint8_t>(std::stoi(hex->substr(i, 2), nullptr, 16)));
+        return bytes;
+      }
+    };
+
+    std::optional<JsonObject> AsObject(Validator &validator, const IJsonValue &value, const std::string &path)
+    {
+      if (value.ValueType() != JsonValueType::Object)
+      {
+        validator.Error(path, "expected an object");
+        return std::nullopt;
+      }
+      return value.GetObject();
+    }
+    // Properties and permissions are combined as flags, their order is irrelevant
+    void AppendFlags(std::ostringstream &layout, const flutter::EncodableList *flags)
+    {
+      std::vector<int64_t> values;
+      if (flags != nullptr)
+      {
+        for (const auto &flag : *flags)
+          values.push_back(std::get<int64_t>(flag));
+      }
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+      for (int64_t value : values)
+        layout << value << ",";
+    }
+  } // namespace
+
+  GattDatabase ParseGattDatabase(const std::wstring &json)
+  {
+    GattDatabase database;
+    Validator validator;
+
+    JsonObject root{nullptr};
+    if (!JsonObject::TryParse(json, root))
+    {
+      database.errors.push_back("$: not a valid JSON object");
+      return database;
+    }
+
+    auto services = validator.Array(root, "$", L"services", true);
+    std::set<std::string> serviceUuids;
+    std::set<std::string> characteristicUuids;
+    for (uint32_t s = 0; services.has_value() && s < services->Size(); ++s)
+    {
+      std::string servicePath = "$.services[" + std::to_string(s) + "]";
+      auto serviceObject = AsObject(validator, services->GetAt(s), servicePath);
+      if (!serviceObject.has_value())
+        continue;
+
+      auto serviceUuid = validator.Uuid(*serviceObject, servicePath);
+      if (serviceUuid.has_value() && !serviceUuids.insert(*serviceUuid).second)
+        validator.Error(servicePath + ".uuid", "duplicate service " + *serviceUuid);
+
+      bool primary = true;
+      if (serviceObject->HasKey(L"primary"))
+      {
+        IJsonValue primaryValue = serviceObject->GetNamedValue(L"primary");
+        if (primaryValue.ValueType() == JsonValueType::Boolean)
+          primary = primaryValue.GetBoolean();
+        else
+          validator.Error(servicePath + ".primary", "expected a boolean");
+      }
+
+      flutter::EncodableList characteristics;
+      auto characteristicArray = validator.Array(*serviceObject, servicePath, L"characteristics", false);
+      for (uint32_t c = 0; characteristicArray.has_value() && c < characteristicArray->Size(); ++c)
+      {
+        std::string characteristicPath = servicePath + ".characteristics[" + std::to_string(c) + "]";
+        auto characteristicObject = AsObject(validator, characteristicArray->GetAt(c), characteristicPath);
+        if (!characteristicObject.has_value())
+          continue;
+
+        // Characteristics are looked up by uuid alone, they have to be unique across services
+        auto characteristicUuid = validator.Uuid(*characteristicObject, characteristicPath);
+        if (characteristicUuid.has_value() && !characteristicUuids.insert(*characteristicUuid).second)
+          validator.Error(characteristicPath + ".uuid", "duplicate characteristic " + *characteristicUuid);
+
+        flutter::EncodableList properties;
+        if (auto names = validator.Array(*characteristicObject, characteristicPath, L"properties", true))
+          properties = validator.Enums(*names, characteristicPath + ".properties", kCharacteristicProperties);
+        flutter::EncodableList permissions;
+        if (auto names = validator.Array(*characteristicObject, characteristicPath, L"permissions", false))
+          permissions = validator.Enums(*names, characteristicPath + ".permissions", kAttributePermissions);
+        auto value = validator.Value(*characteristicObject, characteristicPath);
+
+        flutter::EncodableList descriptors;
+        auto descriptorArray = validator.Array(*characteristicObject, characteristicPath, L"descriptors", false);
+        for (uint32_t d = 0; descriptorArray.has_value() && d < descriptorArray->Size(); ++d)
+        {
+          std::string descriptorPath = characteristicPath + ".descriptors[" + std::to_string(d) + "]";
+          auto descriptorObject = AsObject(validator, descriptorArray->GetAt(d), descriptorPath);
+          if (!descriptorObject.has_value())
+            continue;
+
+          auto descriptorUuid = validator.Uuid(*descriptorObject, descriptorPath);
+          std::optional<flutter::EncodableList> descriptorPermissions;
+          if (auto names = validator.Array(*descriptorObject, descriptorPath, L"permissions", false))
+            descriptorPermissions = validator.Enums(*names, descriptorPath + ".permissions", kAttributePermissions);
+          auto descriptorValue = validator.Value(*descriptorObject, descriptorPath);
+          if (!descriptorUuid.has_value())
+            continue;
+
+          descriptors.push_back(flutter::CustomEncodableValue(BleDescriptor(
+              *descriptorUuid,
+              descriptorValue.has_value() ? &descriptorValue.value() : nullptr,
+              descriptorPermissions.has_value() ? &descriptorPermissions.value() : nullptr)));
+        }
+
+        if (!characteristicUuid.has_value())
+          continue;
+        characteristics.push_back(flutter::CustomEncodableValue(BleCharacteristic(
+            *characteristicUuid, properties, permissions,
+            descriptors.empty() ? nullptr : &descriptors,
+            value.has_value() ? &value.value() : nullptr)));
+      }
+
+      if (serviceUuid.has_value())
+        database.services.emplace_back(*serviceUuid, primary, characteristics);
+    }
+
+    database.errors = std::move(validator.errors);
+    // Partially valid databases are never built
+    if (!database.errors.empty())
+      database.services.clear();
+    return database;
+  }
+
+  std::string GattServiceLayout(const BleService &service)
+  {
+    std::ostringstream layout;
+    layout << to_lower_case(service.uuid()) << (service.primary() ? ";primary" : ";secondary");
+    for (const auto &characteristicEncoded : service.characteristics())
+    {
+      const auto &characteristic = std::any_cast<const BleCharacteristic &>(std::get<flutter::CustomEncodableValue>(characteristicEncoded));
+      layout << "\nc " << to_lower_case(characteristic.uuid()) << ";";
+      AppendFlags(layout, &characteristic.properties());
+      layout << ";";
+      AppendFlags(layout, &characteristic.permissions());
+      if (characteristic.descriptors() == nullptr)
+        continue;
+
+      // Descriptor values are static as well, a changed one needs a new service
+      for (const auto &descriptorEncoded : *characteristic.descriptors())
+      {
+        const auto &descriptor = std::any_cast<const BleDescriptor &>(std::get<flutter::CustomEncodableValue>(descriptorEncoded));
+        layout << "\nd " << to_lower_case(descriptor.uuid()) << ";";
+        AppendFlags(layout, descriptor.permissions());
+        layout << ";" << (descriptor.value() == nullptr ? "-" : to_hexstring(*descriptor.value()));
+      }
+    }
+    return layout.str();
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "BlePeripheral.g.h"
+
+namespace ble_peripheral
+{
+
+    /// Services parsed from a GATT database file, errors holds every schema violation found.
+    /// The file is JSON of the form
+    ///   {"services": [{"uuid": "180F", "primary": true, "characteristics": [
+    ///     {"uuid": "2A19", "properties": ["read", "notify"], "permissions": ["readable"], "value": "64",
+    ///      "descriptors": [{"uuid": "2901", "permissions": ["readable"], "value": "42617474657279"}]}]}]}
+    /// uuids are 16 bit short forms of the Bluetooth base uuid or full 128 bit uuids,
+    /// properties and permissions are the names of CharacteristicProperties and AttributePermissions in Dart,
+    /// values are hex strings
+    struct GattDatabase
+    {
+        std::vector<BleService> services;
+        std::vector<std::string> errors;
+    };
+
+    GattDatabase ParseGattDatabase(const std::wstring &json);
+
+    /// Canonical description of everything fixed once a service is created:
+    /// its uuid, whether it is primary, and per characteristic the uuid, properties, permissions and descriptors.
+    /// Characteristic values are left out, two services with the same layout only differ in values
+    std::string GattServiceLayout(const BleService &service);
+
+} // namespace ble_peripheral
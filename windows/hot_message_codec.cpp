@@ -0,0 +1,99 @@
+#include "hot_message_codec.h"
+
+#include <cstring>
+
+namespace ble_peripheral
+{
+  namespace hot_message
+  {
+    namespace
+    {
+      template <typename T>
+      void Put(uint8_t *at, T value)
+      {
+        std::memcpy(at, &value, sizeof(T));
+      }
+
+      template <typename T>
+      T Get(const uint8_t *at)
+      {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        return value;
+      }
+    } // namespace
+
+    void EncodeAttributeRequest(std::vector<uint8_t> &out,
+                                const std::string &deviceId,
+                                const std::string &characteristicId,
+                                int64_t offset,
+                                const std::vector<uint8_t> *value)
+    {
+      size_t valueLength = value == nullptr ? 0 : value->size();
+      out.resize(kRequestHeaderSize + deviceId.size() + characteristicId.size() + valueLength);
+
+      uint8_t *cursor = out.data();
+      Put<uint16_t>(cursor, static_cast<uint16_t>(deviceId.size()));
+      Put<uint16_t>(cursor + 2, static_cast<uint16_t>(characteristicId.size()));
+      Put<uint32_t>(cursor + 4, value == nullptr ? kNullValue : static_cast<uint32_t>(valueLength));
+      Put<int64_t>(cursor + 8, offset);
+      cursor += kRequestHeaderSize;
+
+      std::memcpy(cursor, deviceId.data(), deviceId.size());
+      cursor += deviceId.size();
+      std::memcpy(cursor, characteristicId.data(), characteristicId.size());
+      cursor += characteristicId.size();
+      if (valueLength > 0)
+        std::memcpy(cursor, value->data(), valueLength);
+    }
+
+    bool DecodeAttributeResult(const uint8_t *message, size_t size, AttributeResultView &result)
+    {
+      if (message == nullptr || size < kResultHeaderSize)
+        return false;
+
+      result.flags = message[0];
+      result.valueLength = Get<uint32_t>(message + 4);
+      result.offset = Get<int64_t>(message + 8);
+      result.status = Get<int64_t>(message + 16);
+      if (result.valueLength > size - kResultHeaderSize)
+        return false;
+      result.value = message + kResultHeaderSize;
+      return true;
+    }
+
+    bool DecodeValueUpdate(const uint8_t *message, size_t size, ValueUpdateView &update)
+    {
+      if (message == nullptr || size < kRequestHeaderSize)
+        return false;
+
+      uint16_t deviceIdLength = Get<uint16_t>(message);
+      uint16_t characteristicIdLength = Get<uint16_t>(message + 2);
+      uint32_t valueLength = Get<uint32_t>(message + 4);
+      size_t deviceIdSize = deviceIdLength == kNullId ? 0 : deviceIdLength;
+      if (size - kRequestHeaderSize < static_cast<size_t>(deviceIdSize) + characteristicIdLength + valueLength)
+        return false;
+
+      const char *cursor = reinterpret_cast<const char *>(message + kRequestHeaderSize);
+      if (deviceIdLength == kNullId)
+        update.deviceId.reset();
+      else
+        update.deviceId.emplace(cursor, deviceIdSize);
+      cursor += deviceIdSize;
+      update.characteristicId.assign(cursor, characteristicIdLength);
+      cursor += characteristicIdLength;
+      update.value = reinterpret_cast<const uint8_t *>(cursor);
+      update.valueLength = valueLength;
+      return true;
+    }
+
+    std::vector<uint8_t> EncodeValueUpdateReply(const std::string *error)
+    {
+      std::vector<uint8_t> reply{static_cast<uint8_t>(error == nullptr ? 0 : 1)};
+      if (error != nullptr)
+        reply.insert(reply.end(), error->begin(), error->end());
+      return reply;
+    }
+
+  } // namespace hot_message
+} // namespace ble_peripheral
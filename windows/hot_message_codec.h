@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ble_peripheral
+{
+
+    /// Fixed layout messages for the calls made once per GATT request or notification,
+    /// carried on raw channels instead of Pigeon, see lib/src/pigeon/hot_message_codec.dart
+    /// Everything is little endian, ids are UTF-8 without terminator.
+    ///
+    /// Attribute request, native to Dart for onReadRequest and onWriteRequest
+    ///   uint16 deviceIdLength, uint16 characteristicIdLength, uint32 valueLength (kNullValue without value),
+    ///   int64 offset, deviceId, characteristicId, value
+    /// Attribute result, the reply of Dart
+    ///   uint8 flags (AttributeResultFlags), 3 bytes padding, uint32 valueLength, int64 offset, int64 status,
+    ///   value, or the UTF-8 error message when kError is set
+    /// Value update, Dart to native for updateCharacteristic
+    ///   uint16 deviceIdLength (kNullId without device), uint16 characteristicIdLength, uint32 valueLength,
+    ///   8 bytes padding, deviceId, characteristicId, value
+    /// Value update reply
+    ///   uint8 0 on success, else 1 followed by the UTF-8 error message
+    /// Read request callback, Dart to native once a readRequest callback is set, empty reply
+    ///   uint8 1
+    namespace hot_message
+    {
+        constexpr const char *kReadRequestChannel = "ble_peripheral/binary/onReadRequest";
+        constexpr const char *kWriteRequestChannel = "ble_peripheral/binary/onWriteRequest";
+        constexpr const char *kUpdateCharacteristicChannel = "ble_peripheral/binary/updateCharacteristic";
+        constexpr const char *kReadRequestCallbackChannel = "ble_peripheral/binary/readRequestCallback";
+
+        constexpr size_t kRequestHeaderSize = 16;
+        constexpr size_t kResultHeaderSize = 24;
+        constexpr uint32_t kNullValue = 0xFFFFFFFF;
+        constexpr uint16_t kNullId = 0xFFFF;
+
+        enum AttributeResultFlags : uint8_t
+        {
+            kNullResult = 1,
+            kHasValue = 2,
+            kHasOffset = 4,
+            kHasStatus = 8,
+            kError = 16,
+        };
+
+        // Points into the reply buffer, only valid while it is
+        struct AttributeResultView
+        {
+            uint8_t flags = 0;
+            const uint8_t *value = nullptr;
+            size_t valueLength = 0;
+            int64_t offset = 0;
+            int64_t status = 0;
+        };
+
+        struct ValueUpdateView
+        {
+            std::string characteristicId;
+            std::optional<std::string> deviceId;
+            const uint8_t *value = nullptr;
+            size_t valueLength = 0;
+        };
+
+        // Replaces the content of out, keeping its capacity
+        void EncodeAttributeRequest(std::vector<uint8_t> &out,
+                                    const std::string &deviceId,
+                                    const std::string &characteristicId,
+                                    int64_t offset,
+                                    const std::vector<uint8_t> *value);
+
+        // Return false if the message is truncated or malformed
+        bool DecodeAttributeResult(const uint8_t *message, size_t size, AttributeResultView &result);
+        bool DecodeValueUpdate(const uint8_t *message, size_t size, ValueUpdateView &update);
+
+        std::vector<uint8_t> EncodeValueUpdateReply(const std::string *error);
+
+    } // namespace hot_message
+
+} // namespace ble_peripheral
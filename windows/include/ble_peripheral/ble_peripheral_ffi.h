@@ -0,0 +1,66 @@
+#ifndef FLUTTER_PLUGIN_BLE_PERIPHERAL_FFI_H_
+#define FLUTTER_PLUGIN_BLE_PERIPHERAL_FFI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ble_peripheral_plugin_c_api.h"
+
+// Data plane of the plugin for dart:ffi, control plane calls stay on the platform channel.
+// Functions may be called from any thread once the plugin is registered.
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define BLE_PERIPHERAL_FFI_OK 0
+#define BLE_PERIPHERAL_FFI_NOT_REGISTERED -1
+#define BLE_PERIPHERAL_FFI_CHARACTERISTIC_NOT_FOUND -2
+#define BLE_PERIPHERAL_FFI_DEVICE_NOT_SUBSCRIBED -3
+#define BLE_PERIPHERAL_FFI_VALUE_EXCEEDS_MTU -4
+#define BLE_PERIPHERAL_FFI_ERROR -5
+
+// Native buffer Dart can fill in place and reuse across calls, released with BlePeripheralFreeBuffer.
+FLUTTER_PLUGIN_EXPORT uint8_t* BlePeripheralAllocBuffer(size_t size);
+
+FLUTTER_PLUGIN_EXPORT void BlePeripheralFreeBuffer(uint8_t* buffer);
+
+// Notifies the subscribers of a characteristic, or only device_id when it is not NULL.
+// Ids are UTF-8 and not null terminated. value is copied before returning,
+// so the caller may reuse its buffer right away. Returns one of the BLE_PERIPHERAL_FFI codes.
+FLUTTER_PLUGIN_EXPORT int32_t BlePeripheralNotifyValue(
+    const char* characteristic_id, size_t characteristic_id_length,
+    const char* device_id, size_t device_id_length,
+    const uint8_t* value, size_t value_length);
+
+// Routes writeWithoutResponse requests of every characteristic into a ring of capacity bytes
+// Dart reads in place, instead of the onWriteRequest or batch callbacks.
+// post_c_object is NativeApi.postCObject, port receives an integer whenever records become readable.
+// Records are 16 byte aligned and little endian:
+//   uint32 record_length, uint16 device_id_length (0xFFFF marks padding up to the end of the ring),
+//   uint16 characteristic_id_length, uint32 offset, uint32 value_length,
+//   then device_id, characteristic_id and value, UTF-8 ids are not null terminated.
+// Starting again replaces the ring, records not read yet are lost.
+// Records that do not fit are dropped and counted in writeRingDropped of getNativeStats.
+FLUTTER_PLUGIN_EXPORT int32_t BlePeripheralWriteRingStart(
+    size_t capacity, void* post_c_object, int64_t port);
+
+FLUTTER_PLUGIN_EXPORT void BlePeripheralWriteRingStop(void);
+
+// Consumer side, to be called from the isolate that started the ring.
+// Call Rearm when the port fires, then read until Readable returns 0.
+FLUTTER_PLUGIN_EXPORT void BlePeripheralWriteRingRearm(void);
+
+// Bytes readable at BlePeripheralWriteRingReadPointer, whole records only
+FLUTTER_PLUGIN_EXPORT size_t BlePeripheralWriteRingReadable(void);
+
+FLUTTER_PLUGIN_EXPORT const uint8_t* BlePeripheralWriteRingReadPointer(void);
+
+// Hands length bytes back to the producer, views into them are invalid afterwards
+FLUTTER_PLUGIN_EXPORT void BlePeripheralWriteRingRelease(size_t length);
+
+#if defined(__cplusplus)
+}  // extern "C"
+#endif
+
+#endif  // FLUTTER_PLUGIN_BLE_PERIPHERAL_FFI_H_
@@ -0,0 +1,199 @@
+#include "logger.h"
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace ble_peripheral
+{
+  namespace
+  {
+    constexpr std::chrono::milliseconds kFlushInterval{50};
+    constexpr char kBinaryMagic[4] = {'B', 'P', 'L', 'G'};
+    constexpr uint32_t kBinaryVersion = 1;
+
+    const char *LevelTag(LogLevel level)
+    {
+      switch (level)
+      {
+      case LogLevel::Debug:
+        return "[D] ";
+      case LogLevel::Info:
+        return "[I] ";
+      case LogLevel::Warning:
+        return "[W] ";
+      default:
+        return "[E] ";
+      }
+    }
+
+    template <typename T>
+    void PutLittleEndian(uint8_t *at, T value)
+    {
+      for (size_t i = 0; i < sizeof(T); i++)
+        at[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+    }
+  } // namespace
+
+  Logger &Logger::Instance()
+  {
+    static Logger *logger = new Logger();
+    return *logger;
+  }
+
+  Logger::Logger() : slots_(std::make_unique<Slot[]>(kCapacity))
+  {
+    for (size_t i = 0; i < kCapacity; i++)
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+
+    char *path = nullptr;
+    size_t pathLength = 0;
+    if (_dupenv_s(&path, &pathLength, "BLE_PERIPHERAL_LOG_FILE") == 0 && path != nullptr)
+    {
+      if (fopen_s(&binaryFile_, path, "ab") == 0 && binaryFile_ != nullptr)
+      {
+        if (ftell(binaryFile_) == 0)
+        {
+          uint8_t header[8];
+          std::memcpy(header, kBinaryMagic, sizeof(kBinaryMagic));
+          PutLittleEndian(header + 4, kBinaryVersion);
+          fwrite(header, 1, sizeof(header), binaryFile_);
+        }
+      }
+      else
+      {
+        std::cerr << "Failed to open log file " << path << std::endl;
+        binaryFile_ = nullptr;
+      }
+      free(path);
+    }
+
+    std::thread(&Logger::Run, this).detach();
+  }
+
+  void Logger::Write(LogLevel level, const char *message, size_t length)
+  {
+    uint64_t position = head_.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;)
+    {
+      slot = &slots_[position % kCapacity];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+      if (difference == 0)
+      {
+        if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (difference < 0)
+      {
+        // Full, the flusher is behind
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      else
+      {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    Record &record = slot->record;
+    record.timestampNanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::system_clock::now().time_since_epoch())
+                                                      .count());
+    record.threadId = GetCurrentThreadId();
+    record.level = level;
+    record.length = static_cast<uint16_t>(length < kMessageSize ? length : kMessageSize);
+    std::memcpy(record.message, message, record.length);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    // Errors are written out right away, notify_one does not wait for the flusher
+    if (level == LogLevel::Error)
+      wake_.notify_one();
+  }
+
+  void Logger::Flush()
+  {
+    std::lock_guard<std::mutex> lock(consumerMutex_);
+    DrainLocked();
+  }
+
+  void Logger::Run()
+  {
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait_for(lock, kFlushInterval);
+      }
+      Flush();
+    }
+  }
+
+  void Logger::DrainLocked()
+  {
+    bool emitted = false;
+    for (;;)
+    {
+      Slot &slot = slots_[tail_ % kCapacity];
+      if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1)
+        break;
+      Emit(slot.record);
+      emitted = true;
+      slot.sequence.store(tail_ + kCapacity, std::memory_order_release);
+      tail_++;
+    }
+    if (!emitted)
+      return;
+    std::cout.flush();
+    if (binaryFile_ != nullptr)
+      fflush(binaryFile_);
+  }
+
+  void Logger::Emit(const Record &record)
+  {
+    std::string_view message(record.message, record.length);
+    if (record.level == LogLevel::Error)
+      std::cerr << LevelTag(record.level) << message << std::endl;
+    else
+      std::cout << LevelTag(record.level) << message << '\n';
+
+    if (binaryFile_ == nullptr)
+      return;
+    uint8_t header[16];
+    PutLittleEndian(header, record.timestampNanos);
+    PutLittleEndian(header + 8, record.threadId);
+    header[12] = static_cast<uint8_t>(record.level);
+    header[13] = 0;
+    PutLittleEndian(header + 14, record.length);
+    fwrite(header, 1, sizeof(header), binaryFile_);
+    fwrite(record.message, 1, record.length, binaryFile_);
+  }
+
+  void LogLine::Append(std::string_view text)
+  {
+    size_t count = text.size() < sizeof(buffer_) - size_ ? text.size() : sizeof(buffer_) - size_;
+    std::memcpy(buffer_ + size_, text.data(), count);
+    size_ += count;
+  }
+
+  void LogLine::Append(std::wstring_view text)
+  {
+    size_t remaining = sizeof(buffer_) - size_;
+    if (text.empty() || remaining == 0)
+      return;
+    // A UTF-16 unit takes at most 3 UTF-8 bytes, longer text is cut to what surely fits
+    size_t units = text.size() * 3 <= remaining ? text.size() : remaining / 3;
+    if (units > 0 && units < text.size() && IS_HIGH_SURROGATE(text[units - 1]))
+      units--;
+    int written = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(units),
+                                      buffer_ + size_, static_cast<int>(remaining), nullptr, nullptr);
+    if (written > 0)
+      size_ += static_cast<size_t>(written);
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <winrt/base.h>
+
+// Levels below are compiled out, 0 debug, 1 info, 2 warning, 3 error
+#ifndef BLE_PERIPHERAL_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define BLE_PERIPHERAL_MIN_LOG_LEVEL 1
+#else
+#define BLE_PERIPHERAL_MIN_LOG_LEVEL 0
+#endif
+#endif
+
+namespace ble_peripheral
+{
+
+    enum class LogLevel : uint8_t
+    {
+        Debug = 0,
+        Info = 1,
+        Warning = 2,
+        Error = 3,
+    };
+
+    /// Fixed size log records in a lock-free multi-producer ring, drained by a background thread
+    /// to stdout/stderr and, when BLE_PERIPHERAL_LOG_FILE names a file, appended to it in binary.
+    /// Writers never block or allocate, a record finding the ring full is dropped and counted.
+    ///
+    /// Binary file: "BPLG" followed by a u32 version (1), then per record a 16 byte little endian header,
+    /// u64 unix time in nanoseconds, u32 thread id, u8 level, u8 reserved, u16 message length,
+    /// followed by the UTF-8 message
+    class Logger
+    {
+    public:
+        static constexpr size_t kCapacity = 1024;
+        static constexpr size_t kMessageSize = 232;
+
+        // Never destroyed, joining the flusher from static destructors would deadlock on the loader lock
+        static Logger &Instance();
+
+        Logger(const Logger &) = delete;
+        Logger &operator=(const Logger &) = delete;
+
+        void Write(LogLevel level, const char *message, size_t length);
+        // Writes out everything queued so far on the calling thread
+        void Flush();
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Record
+        {
+            uint64_t timestampNanos;
+            uint32_t threadId;
+            LogLevel level;
+            uint16_t length;
+            char message[kMessageSize];
+        };
+
+        struct Slot
+        {
+            // Vyukov bounded queue sequence, equals the position once the slot is free to write
+            std::atomic<uint64_t> sequence;
+            Record record;
+        };
+
+        Logger();
+        void Run();
+        // Requires consumerMutex_
+        void DrainLocked();
+        void Emit(const Record &record);
+
+        std::unique_ptr<Slot[]> slots_;
+        std::atomic<uint64_t> head_{0};
+        std::atomic<uint64_t> dropped_{0};
+
+        std::mutex consumerMutex_;
+        uint64_t tail_ = 0;
+        FILE *binaryFile_ = nullptr;
+
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+    };
+
+    /// Formats the arguments of one log call into a stack buffer, longer messages are truncated
+    class LogLine
+    {
+    public:
+        void Append(std::string_view text);
+        void Append(const char *text) { Append(text == nullptr ? std::string_view("(null)") : std::string_view(text)); }
+        void Append(const std::string &text) { Append(std::string_view(text)); }
+        void Append(std::wstring_view text);
+        void Append(const wchar_t *text) { Append(text == nullptr ? std::wstring_view(L"(null)") : std::wstring_view(text)); }
+        void Append(const winrt::hstring &text) { Append(std::wstring_view(text)); }
+        void Append(winrt::hresult result) { Append(static_cast<int32_t>(result)); }
+        void Append(char c) { Append(std::string_view(&c, 1)); }
+        void Append(bool value) { Append(value ? std::string_view("true") : std::string_view("false")); }
+
+        template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+        void Append(T value)
+        {
+            char digits[32];
+            auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+            if (error == std::errc())
+                Append(std::string_view(digits, end - digits));
+        }
+
+        const char *data() const { return buffer_; }
+        size_t size() const { return size_; }
+
+    private:
+        char buffer_[Logger::kMessageSize];
+        size_t size_ = 0;
+    };
+
+    template <typename... Args>
+    void Log(LogLevel level, const Args &...args)
+    {
+        LogLine line;
+        (line.Append(args), ...);
+        Logger::Instance().Write(level, line.data(), line.size());
+    }
+
+} // namespace ble_peripheral
+
+#define BLE_PERIPHERAL_LOG(level, ...)                                                  \
+    do                                                                                  \
+    {                                                                                   \
+        if constexpr (static_cast<int>(level) >= BLE_PERIPHERAL_MIN_LOG_LEVEL)          \
+            ::ble_peripheral::Log(level, __VA_ARGS__);                                  \
+    } while (false)
+
+#define BLE_LOG_DEBUG(...) BLE_PERIPHERAL_LOG(::ble_peripheral::LogLevel::Debug, __VA_ARGS__)
+#define BLE_LOG_INFO(...) BLE_PERIPHERAL_LOG(::ble_peripheral::LogLevel::Info, __VA_ARGS__)
+#define BLE_LOG_WARNING(...) BLE_PERIPHERAL_LOG(::ble_peripheral::LogLevel::Warning, __VA_ARGS__)
+#define BLE_LOG_ERROR(...) BLE_PERIPHERAL_LOG(::ble_peripheral::LogLevel::Error, __VA_ARGS__)
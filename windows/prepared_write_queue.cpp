@@ -0,0 +1,71 @@
+#include "prepared_write_queue.h"
+
+#include <iterator>
+
+namespace ble_peripheral
+{
+
+  PreparedWriteQueue::PreparedWriteQueue() : PreparedWriteQueue(Limits{}) {}
+
+  PreparedWriteQueue::PreparedWriteQueue(Limits limits) : limits_(limits) {}
+
+  PreparedWriteQueue::Result PreparedWriteQueue::Append(const std::string &deviceId, const std::string &characteristicId,
+                                                        uint32_t offset, size_t size, size_t maxFragmentSize)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key{deviceId, characteristicId};
+    auto it = nextOffsets_.find(key);
+
+    // A write at offset 0 starts over, whatever came before it was complete
+    if (offset == 0)
+    {
+      if (it != nextOffsets_.end())
+        nextOffsets_.erase(it);
+      it = nextOffsets_.end();
+    }
+    else if (it == nextOffsets_.end() || it->second != offset)
+    {
+      if (it != nextOffsets_.end())
+        nextOffsets_.erase(it);
+      return Result::InvalidOffset;
+    }
+
+    size_t end = static_cast<size_t>(offset) + size;
+    if (end > limits_.maxValueLength)
+    {
+      if (it != nextOffsets_.end())
+        nextOffsets_.erase(it);
+      return Result::InvalidLength;
+    }
+
+    // Only a full sized fragment can be followed by another one
+    if (maxFragmentSize == 0 || size < maxFragmentSize || end == limits_.maxValueLength)
+    {
+      if (it != nextOffsets_.end())
+        nextOffsets_.erase(it);
+      return Result::Complete;
+    }
+
+    nextOffsets_[key] = end;
+    return Result::Continues;
+  }
+
+  void PreparedWriteQueue::ClearSession(const std::string &deviceId)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = nextOffsets_.begin(); it != nextOffsets_.end();)
+    {
+      auto next = std::next(it);
+      if (it->first.first == deviceId)
+        nextOffsets_.erase(it);
+      it = next;
+    }
+  }
+
+  size_t PreparedWriteQueue::OpenWrites() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextOffsets_.size();
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace ble_peripheral
+{
+
+    /// Follows prepared (long) writes of a session and characteristic by offset.
+    /// WinRT surfaces every prepare fragment as a separate write request and raises no execute write event,
+    /// so a full sized write at offset 0 cannot be told apart from the first fragment of a long write.
+    /// Nothing is held back or reassembled: each fragment is answered as it arrives and reaches Dart with its
+    /// offset, like on Android. The queue only checks that a fragment continues the write before it.
+    /// ATT allows one outstanding request per bearer, fragments of a session always arrive one after another
+    class PreparedWriteQueue
+    {
+    public:
+        enum class Result
+        {
+            // The write ends the value, an ordinary write or the last fragment of a long write
+            Complete,
+            // Full sized fragment, a fragment continuing it may follow
+            Continues,
+            // Fragment does not continue the write before it
+            InvalidOffset,
+            // Value would exceed maxValueLength
+            InvalidLength,
+        };
+
+        struct Limits
+        {
+            // Maximum length of an attribute value, per Core spec Vol 3, Part F, 3.2.9
+            size_t maxValueLength = 512;
+        };
+
+        PreparedWriteQueue();
+        explicit PreparedWriteQueue(Limits limits);
+
+        PreparedWriteQueue(const PreparedWriteQueue &) = delete;
+        PreparedWriteQueue &operator=(const PreparedWriteQueue &) = delete;
+
+        // maxFragmentSize is ATT_MTU - 5, the most value a Prepare Write Request carries
+        Result Append(const std::string &deviceId, const std::string &characteristicId,
+                      uint32_t offset, size_t size, size_t maxFragmentSize);
+
+        // Forgets the writes of a device, e.g. when its session closes
+        void ClearSession(const std::string &deviceId);
+
+        // Writes that may still be continued
+        size_t OpenWrites() const;
+
+    private:
+        using Key = std::pair<std::string, std::string>;
+
+        mutable std::mutex mutex_;
+        Limits limits_;
+        // Offset the next fragment of each open write starts at
+        std::map<Key, size_t> nextOffsets_;
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ble_peripheral
+{
+
+    /// Services by uuid, published as immutable versions.
+    /// Readers take a snapshot with a single atomic load and never wait for a writer,
+    /// writers copy the current version, change the copy and publish it, one writer at a time.
+    /// TService exposes characteristics, a map of characteristic uuid to TCharacteristic pointers it owns
+    template <typename TService, typename TCharacteristic>
+    class ServiceRegistry
+    {
+    public:
+        struct Version
+        {
+            std::map<std::string, std::shared_ptr<TService>> services;
+            // Characteristics of every service by uuid, sharing ownership of their service
+            std::unordered_map<std::string, std::shared_ptr<TCharacteristic>> characteristics;
+        };
+        using Snapshot = std::shared_ptr<const Version>;
+
+        ServiceRegistry() : current_(std::make_shared<const Version>()) {}
+
+        ServiceRegistry(const ServiceRegistry &) = delete;
+        ServiceRegistry &operator=(const ServiceRegistry &) = delete;
+
+        Snapshot snapshot() const { return std::atomic_load(&current_); }
+
+        std::shared_ptr<TService> Find(const std::string &serviceId) const
+        {
+            auto version = snapshot();
+            auto it = version->services.find(serviceId);
+            return it == version->services.end() ? nullptr : it->second;
+        }
+
+        std::shared_ptr<TCharacteristic> FindCharacteristic(const std::string &characteristicId) const
+        {
+            auto version = snapshot();
+            auto it = version->characteristics.find(characteristicId);
+            return it == version->characteristics.end() ? nullptr : it->second;
+        }
+
+        // Publishes service under serviceId, returns the service it replaced if any
+        std::shared_ptr<TService> Insert(const std::string &serviceId, std::shared_ptr<TService> service)
+        {
+            std::shared_ptr<TService> previous;
+            Publish([&](std::map<std::string, std::shared_ptr<TService>> &services)
+                    {
+                      auto &slot = services[serviceId];
+                      previous = std::move(slot);
+                      slot = std::move(service); });
+            return previous;
+        }
+
+        // Unpublishes serviceId, returns the removed service if any
+        std::shared_ptr<TService> Remove(const std::string &serviceId)
+        {
+            std::shared_ptr<TService> removed;
+            Publish([&](std::map<std::string, std::shared_ptr<TService>> &services)
+                    {
+                      auto it = services.find(serviceId);
+                      if (it == services.end())
+                        return;
+                      removed = std::move(it->second);
+                      services.erase(it); });
+            return removed;
+        }
+
+        // Unpublishes every service, returns them
+        std::vector<std::shared_ptr<TService>> Clear()
+        {
+            std::vector<std::shared_ptr<TService>> removed;
+            Publish([&](std::map<std::string, std::shared_ptr<TService>> &services)
+                    {
+                      for (auto &[serviceId, service] : services)
+                        removed.push_back(std::move(service));
+                      services.clear(); });
+            return removed;
+        }
+
+    private:
+        template <typename Mutation>
+        void Publish(Mutation &&mutate)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            auto next = std::make_shared<Version>();
+            next->services = std::atomic_load(&current_)->services;
+            mutate(next->services);
+
+            // The first service declaring a characteristic wins, like the linear lookup it replaces
+            for (const auto &[serviceId, service] : next->services)
+            {
+                for (const auto &[characteristicId, characteristic] : service->characteristics)
+                    next->characteristics.try_emplace(characteristicId, service, characteristic);
+            }
+            std::atomic_store(&current_, std::shared_ptr<const Version>(std::move(next)));
+        }
+
+        // Serializes writers only, readers never take it
+        std::mutex writeMutex_;
+        std::shared_ptr<const Version> current_;
+    };
+
+} // namespace ble_peripheral
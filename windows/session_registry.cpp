@@ -0,0 +1,93 @@
+#include "session_registry.h"
+
+#include <utility>
+
+namespace ble_peripheral
+{
+  using winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSession;
+  using winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSessionStatus;
+  using winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSessionStatusChangedEventArgs;
+
+  SessionRegistry::SessionRegistry(Callbacks callbacks) : callbacks_(std::move(callbacks)) {}
+
+  SessionRegistry::~SessionRegistry()
+  {
+    Clear();
+  }
+
+  void SessionRegistry::Track(const std::string &deviceId, GattSession const &session)
+  {
+    uint16_t maxPduSize = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (sessions_.find(deviceId) != sessions_.end())
+        return;
+
+      Entry entry;
+      entry.session = session;
+      entry.maxPduSize = session.MaxPduSize();
+      entry.statusRevoker = session.SessionStatusChanged(
+          winrt::auto_revoke,
+          [this, deviceId](GattSession const &, GattSessionStatusChangedEventArgs const &args)
+          { OnSessionStatusChanged(deviceId, args.Status()); });
+      entry.maxPduSizeRevoker = session.MaxPduSizeChanged(
+          winrt::auto_revoke,
+          [this, deviceId](GattSession const &sender, winrt::Windows::Foundation::IInspectable const &)
+          { OnMaxPduSizeChanged(deviceId, sender.MaxPduSize()); });
+      maxPduSize = entry.maxPduSize;
+      sessions_.emplace(deviceId, std::move(entry));
+    }
+
+    callbacks_.onConnectionStateChange(deviceId, true);
+    callbacks_.onMtuChange(deviceId, maxPduSize);
+  }
+
+  std::optional<uint16_t> SessionRegistry::MaxPduSize(const std::string &deviceId) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(deviceId);
+    if (it == sessions_.end())
+      return std::nullopt;
+    return it->second.maxPduSize;
+  }
+
+  void SessionRegistry::Clear()
+  {
+    std::unordered_map<std::string, Entry> sessions;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sessions.swap(sessions_);
+    }
+    // Revokers run outside of the lock, a handler may be waiting for it
+  }
+
+  void SessionRegistry::OnSessionStatusChanged(const std::string &deviceId, GattSessionStatus status)
+  {
+    if (status != GattSessionStatus::Closed)
+      return;
+
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = sessions_.find(deviceId);
+      if (it == sessions_.end())
+        return;
+      entry = std::move(it->second);
+      sessions_.erase(it);
+    }
+    callbacks_.onConnectionStateChange(deviceId, false);
+  }
+
+  void SessionRegistry::OnMaxPduSizeChanged(const std::string &deviceId, uint16_t maxPduSize)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = sessions_.find(deviceId);
+      if (it == sessions_.end() || it->second.maxPduSize == maxPduSize)
+        return;
+      it->second.maxPduSize = maxPduSize;
+    }
+    callbacks_.onMtuChange(deviceId, maxPduSize);
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <winrt/Windows.Devices.Bluetooth.GenericAttributeProfile.h>
+
+namespace ble_peripheral
+{
+
+    /// Tracks the GattSession of every connected central by device id.
+    /// A GattServiceProvider has no connection event, sessions are learned from requests and subscriptions,
+    /// and dropped once their SessionStatusChanged reports Closed
+    class SessionRegistry
+    {
+    public:
+        // Called outside of the registry lock, from the WinRT thread that observed the change
+        struct Callbacks
+        {
+            std::function<void(const std::string &deviceId, bool connected)> onConnectionStateChange;
+            std::function<void(const std::string &deviceId, uint16_t maxPduSize)> onMtuChange;
+        };
+
+        explicit SessionRegistry(Callbacks callbacks);
+        ~SessionRegistry();
+
+        SessionRegistry(const SessionRegistry &) = delete;
+        SessionRegistry &operator=(const SessionRegistry &) = delete;
+
+        // Starts tracking session unless it is known already,
+        // reports the device as connected along with its current MaxPduSize
+        void Track(const std::string &deviceId,
+                   winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSession const &session);
+
+        std::optional<uint16_t> MaxPduSize(const std::string &deviceId) const;
+
+        // Forgets all sessions without reporting them as disconnected
+        void Clear();
+
+    private:
+        struct Entry
+        {
+            winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSession session{nullptr};
+            uint16_t maxPduSize = 0;
+            winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSession::SessionStatusChanged_revoker statusRevoker;
+            winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSession::MaxPduSizeChanged_revoker maxPduSizeRevoker;
+        };
+
+        void OnSessionStatusChanged(const std::string &deviceId,
+                                    winrt::Windows::Devices::Bluetooth::GenericAttributeProfile::GattSessionStatus status);
+        void OnMaxPduSizeChanged(const std::string &deviceId, uint16_t maxPduSize);
+
+        mutable std::mutex mutex_;
+        Callbacks callbacks_;
+        std::unordered_map<std::string, Entry> sessions_;
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,182 @@
+#include "advertising_payload.h"
+#include "check.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+  using namespace ble_peripheral::ad;
+
+  // Fixed payloads are checked against the budget while compiling
+  constexpr auto kBeacon = Concat(Section(kFlags, std::array<uint8_t, 1>{kGeneralDiscoverableFlags}),
+                                  Section(kCompleteServiceUuids16, std::array<uint8_t, 2>{0x0F, 0x18}),
+                                  Section(kManufacturerData, std::array<uint8_t, 3>{0x4c, 0x00, 0x01}));
+  static_assert(kBeacon.size() == SectionSize(1) + SectionSize(2) + SectionSize(3));
+  static_assert(kBeacon.size() <= kLegacyBudget);
+  static_assert(kBeacon[0] == 2 && kBeacon[1] == kFlags && kBeacon[3] == 3 && kBeacon[4] == kCompleteServiceUuids16);
+  static_assert(IsShortUuid(FromShortUuid(0x180F)) && ShortUuid(FromShortUuid(0x180F)) == 0x180F);
+
+  Uuid LongUuid(uint8_t seed)
+  {
+    Uuid uuid{};
+    for (size_t i = 0; i < uuid.size(); ++i)
+      uuid[i] = static_cast<uint8_t>(seed + i);
+    return uuid;
+  }
+
+  bool Contains(const Encoded &encoded, Field field)
+  {
+    return std::find(encoded.truncated.begin(), encoded.truncated.end(), field) != encoded.truncated.end();
+  }
+
+  // Whether text ends on a UTF-8 sequence boundary
+  bool IsWholeUtf8(const std::string &text)
+  {
+    size_t i = 0;
+    while (i < text.size())
+    {
+      uint8_t lead = static_cast<uint8_t>(text[i]);
+      size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+      if (i + length > text.size())
+        return false;
+      i += length;
+    }
+    return true;
+  }
+
+  void RoundTrip()
+  {
+    Fields fields;
+    fields.flags = kGeneralDiscoverableFlags;
+    fields.serviceUuids = {FromShortUuid(0x180F), LongUuid(1), FromShortUuid(0x180A)};
+    fields.localName = "Peripheral";
+    fields.manufacturerId = 0x004C;
+    fields.manufacturerData = {1, 2, 3};
+    fields.serviceData.push_back({FromShortUuid(0x1234), {9, 8}});
+    fields.serviceData.push_back({LongUuid(7), {5}});
+
+    Encoded encoded = Encode(fields, kExtendedBudget);
+    CHECK(encoded.fits());
+    CHECK(encoded.payload.size() == EncodedSize(fields));
+
+    auto decoded = Decode(encoded.payload.data(), encoded.payload.size());
+    CHECK(decoded.has_value());
+    if (!decoded.has_value())
+      return;
+    CHECK(decoded->flags == fields.flags);
+    CHECK(decoded->serviceUuids.size() == 3);
+    CHECK(std::count(decoded->serviceUuids.begin(), decoded->serviceUuids.end(), LongUuid(1)) == 1);
+    CHECK(decoded->serviceUuidsComplete);
+    CHECK(decoded->localName == fields.localName);
+    CHECK(decoded->localNameComplete);
+    CHECK(decoded->manufacturerId == fields.manufacturerId);
+    CHECK(decoded->manufacturerData == fields.manufacturerData);
+    CHECK(decoded->serviceData.size() == 2);
+    CHECK(decoded->serviceData[0].uuid == FromShortUuid(0x1234) && decoded->serviceData[0].data == std::vector<uint8_t>({9, 8}));
+    CHECK(decoded->serviceData[1].uuid == LongUuid(7) && decoded->serviceData[1].data == std::vector<uint8_t>({5}));
+  }
+
+  void DecodeRejectsOverrun()
+  {
+    const uint8_t overrun[] = {5, kFlags, 0x06};
+    CHECK(!Decode(overrun, sizeof(overrun)).has_value());
+
+    // Zero length ends the significant part, 32 bit uuids widen into the base uuid
+    const uint8_t padded[] = {5, kCompleteServiceUuids32, 0x78, 0x56, 0x34, 0x12, 0, 0xFF};
+    auto decoded = Decode(padded, sizeof(padded));
+    CHECK(decoded.has_value() && decoded->serviceUuids.size() == 1);
+    if (decoded.has_value() && decoded->serviceUuids.size() == 1)
+      CHECK(decoded->serviceUuids[0][0] == 0x12 && decoded->serviceUuids[0][3] == 0x78);
+  }
+
+  void PrefersShortUuids()
+  {
+    Fields fields;
+    fields.serviceUuids = {LongUuid(1), FromShortUuid(0x180F)};
+
+    Encoded encoded = Encode(fields, kLegacyBudget);
+    CHECK(encoded.fits());
+    // The 16 bit list comes first and takes 2 bytes per uuid
+    CHECK(encoded.payload[0] == 3 && encoded.payload[1] == kCompleteServiceUuids16);
+    CHECK(encoded.payload[2] == 0x0F && encoded.payload[3] == 0x18);
+    CHECK(encoded.payload[5] == kCompleteServiceUuids128);
+
+    // Without room for the 128 bit uuid the 16 bit one still goes in
+    encoded = Encode(fields, SectionSize(2) + SectionSize(15));
+    CHECK(encoded.payload.size() == SectionSize(2));
+    CHECK(encoded.payload[1] == kCompleteServiceUuids16);
+    CHECK(Contains(encoded, Field::ServiceUuids));
+  }
+
+  void MarksIncompleteUuidLists()
+  {
+    Fields fields;
+    for (uint16_t i = 0; i < 20; ++i)
+      fields.serviceUuids.push_back(FromShortUuid(static_cast<uint16_t>(0x1800 + i)));
+
+    Encoded encoded = Encode(fields, kLegacyBudget);
+    CHECK(!encoded.fits());
+    CHECK(Contains(encoded, Field::ServiceUuids));
+    CHECK(encoded.payload[1] == kIncompleteServiceUuids16);
+    CHECK(encoded.payload.size() <= kLegacyBudget);
+
+    auto decoded = Decode(encoded.payload.data(), encoded.payload.size());
+    CHECK(decoded.has_value() && !decoded->serviceUuidsComplete);
+    if (decoded.has_value())
+      CHECK(decoded->serviceUuids.size() == (kLegacyBudget - SectionSize(0)) / 2);
+  }
+
+  void ShortensLocalNameOnUtf8Boundary()
+  {
+    Fields fields;
+    fields.flags = kGeneralDiscoverableFlags;
+    // Every "é" is two bytes, after the leading "x" the room left ends inside one
+    fields.localName = "x\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9";
+
+    Encoded encoded = Encode(fields, kLegacyBudget);
+    CHECK(Contains(encoded, Field::LocalName));
+    CHECK(encoded.payload.size() <= kLegacyBudget);
+
+    auto decoded = Decode(encoded.payload.data(), encoded.payload.size());
+    CHECK(decoded.has_value() && decoded->localName.has_value());
+    if (!decoded.has_value() || !decoded->localName.has_value())
+      return;
+    CHECK(!decoded->localNameComplete);
+    CHECK(IsWholeUtf8(*decoded->localName));
+    CHECK(decoded->localName->size() == kLegacyBudget - SectionSize(1) - SectionSize(0) - 1);
+    CHECK(fields.localName->compare(0, decoded->localName->size(), *decoded->localName) == 0);
+  }
+
+  void ReportsTruncatedFields()
+  {
+    Fields fields;
+    fields.flags = kGeneralDiscoverableFlags;
+    fields.manufacturerId = 0x004C;
+    fields.manufacturerData.assign(40, 0xAB);
+    fields.serviceData.push_back({LongUuid(3), std::vector<uint8_t>(20, 1)});
+
+    Encoded encoded = Encode(fields, kLegacyBudget);
+    CHECK(!encoded.fits());
+    CHECK(Contains(encoded, Field::ManufacturerData));
+    CHECK(Contains(encoded, Field::ServiceData));
+    CHECK(!Contains(encoded, Field::Flags));
+    // Fields left out whole leave no partial structure behind
+    CHECK(encoded.payload.size() == SectionSize(1));
+    CHECK(std::string(FieldName(Field::ManufacturerData)) == "manufacturerData");
+
+    CHECK(Encode(fields, kExtendedBudget).fits());
+  }
+} // namespace
+
+int main()
+{
+  RoundTrip();
+  DecodeRejectsOverrun();
+  PrefersShortUuids();
+  MarksIncompleteUuidLists();
+  ShortensLocalNameOnUtf8Boundary();
+  ReportsTruncatedFields();
+
+  return ble_peripheral::test::Finish("advertising_payload_test");
+}
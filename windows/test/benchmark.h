@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ble_peripheral
+{
+    namespace benchmark
+    {
+        // Written by every measured body so the compiler cannot drop the work as unused
+        inline volatile uint64_t sink = 0;
+
+        // Iterations from the first argument, so ctest can run the comparison quickly
+        inline int Iterations(int argc, char **argv, int fallback)
+        {
+            int iterations = argc > 1 ? std::atoi(argv[1]) : fallback;
+            return iterations > 0 ? iterations : fallback;
+        }
+
+        // Runs body after a tenth of the iterations as warm up and prints the mean nanoseconds per call
+        template <typename Body>
+        double Measure(const char *name, int iterations, Body &&body)
+        {
+            for (int i = 0; i < iterations / 10; ++i)
+                body();
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i)
+                body();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+            double nanos = elapsed.count() / iterations;
+            std::printf("  %-44s %10.1f ns\n", name, nanos);
+            return nanos;
+        }
+
+        inline void Compare(const char *what, double baseline, double candidate)
+        {
+            std::printf("  %-44s %10.2fx\n", what, candidate > 0 ? baseline / candidate : 0.0);
+        }
+
+    } // namespace benchmark
+} // namespace ble_peripheral
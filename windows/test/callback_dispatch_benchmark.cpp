@@ -0,0 +1,142 @@
+#include "BlePeripheral.g.h"
+#include "benchmark.h"
+#include "callback_dispatcher.h"
+#include "hot_message_codec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// Per callback cost of the generated BleCallback against BleCallbackDispatcher, both sending through a
+// messenger that answers at once with the reply Dart would give, so only the native side is measured
+namespace
+{
+  using namespace ble_peripheral;
+  using flutter::CustomEncodableValue;
+  using flutter::EncodableList;
+  using flutter::EncodableValue;
+
+  const std::string kDeviceId = "BluetoothLE#BluetoothLEd0:c6:37:5a:21:0f-4c:11:ae:90:3b:e2";
+  const std::string kCharacteristicId = "6e400003-b5a3-f393-e0a9-e50e24dcca9e";
+  const std::string kPigeonPrefix = "dev.flutter.pigeon.ble_peripheral.BleCallback.";
+
+  int failures = 0;
+
+  class ReplyingMessenger : public flutter::BinaryMessenger
+  {
+  public:
+    void Reply(const std::string &channel, std::vector<uint8_t> reply) { replies_[channel] = std::move(reply); }
+
+    void Send(const std::string &channel, const uint8_t *, size_t, flutter::BinaryReply reply) const override
+    {
+      if (reply == nullptr)
+        return;
+      auto it = replies_.find(channel);
+      if (it == replies_.end())
+        reply(nullptr, 0);
+      else
+        reply(it->second.data(), it->second.size());
+    }
+
+    void SetMessageHandler(const std::string &, flutter::BinaryMessageHandler) override {}
+
+  private:
+    std::map<std::string, std::vector<uint8_t>> replies_;
+  };
+
+  // The reply Dart encodes in lib/src/pigeon/hot_message_codec.dart
+  std::vector<uint8_t> AttributeResult(const std::vector<uint8_t> &value)
+  {
+    std::vector<uint8_t> reply(hot_message::kResultHeaderSize + value.size());
+    uint32_t valueLength = static_cast<uint32_t>(value.size());
+    reply[0] = hot_message::kHasValue;
+    std::memcpy(reply.data() + 4, &valueLength, sizeof(valueLength));
+    std::memcpy(reply.data() + hot_message::kResultHeaderSize, value.data(), value.size());
+    return reply;
+  }
+
+  void OnError(const FlutterError &error)
+  {
+    std::fprintf(stderr, "Callback failed: %s\n", error.message().c_str());
+    failures++;
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  int iterations = benchmark::Iterations(argc, argv, 200000);
+  const flutter::StandardMessageCodec &codec = BleCallback::GetCodec();
+  std::vector<uint8_t> value(244);
+  for (size_t i = 0; i < value.size(); ++i)
+    value[i] = static_cast<uint8_t>(i * 7);
+
+  ReplyingMessenger messenger;
+  messenger.Reply(kPigeonPrefix + "onMtuChange", *codec.EncodeMessage(EncodableValue(EncodableList{})));
+  messenger.Reply(kPigeonPrefix + "onReadRequest",
+                  *codec.EncodeMessage(EncodableValue(EncodableList{CustomEncodableValue(ReadRequestResult(value))})));
+  messenger.Reply(hot_message::kReadRequestChannel, AttributeResult(value));
+
+  BleCallback callback(&messenger);
+  BleCallbackDispatcher dispatcher(&messenger);
+
+  // Both deliver the same result before anything is timed
+  size_t callbackValue = 0;
+  size_t dispatcherValue = 0;
+  callback.OnReadRequest(
+      kDeviceId, kCharacteristicId, 0, nullptr,
+      [&](const ReadRequestResult *result)
+      { callbackValue = result != nullptr && result->value() == value ? value.size() : 0; },
+      OnError);
+  dispatcher.OnReadRequest(
+      kDeviceId, kCharacteristicId, 0, nullptr,
+      [&](const ReadRequestResult *result)
+      { dispatcherValue = result != nullptr && result->value() == value ? value.size() : 0; },
+      OnError);
+  if (callbackValue != value.size() || dispatcherValue != value.size())
+  {
+    std::fprintf(stderr, "Read request results differ\n");
+    failures++;
+  }
+
+  std::printf("onMtuChange, void reply\n");
+  double callbackMtu = benchmark::Measure(
+      "BleCallback", iterations,
+      [&]
+      {
+        callback.OnMtuChange(kDeviceId, 247, [] { benchmark::sink = benchmark::sink + 1; }, OnError);
+      });
+  double dispatcherMtu = benchmark::Measure(
+      "BleCallbackDispatcher", iterations,
+      [&]
+      {
+        dispatcher.OnMtuChange(kDeviceId, 247, [] { benchmark::sink = benchmark::sink + 1; }, OnError);
+      });
+  benchmark::Compare("speedup", callbackMtu, dispatcherMtu);
+
+  std::printf("onReadRequest, %zu byte value replied\n", value.size());
+  double callbackRead = benchmark::Measure(
+      "BleCallback", iterations,
+      [&]
+      {
+        callback.OnReadRequest(
+            kDeviceId, kCharacteristicId, 0, nullptr,
+            [](const ReadRequestResult *result)
+            { benchmark::sink = benchmark::sink + result->value().size(); },
+            OnError);
+      });
+  double dispatcherRead = benchmark::Measure(
+      "BleCallbackDispatcher", iterations,
+      [&]
+      {
+        dispatcher.OnReadRequest(
+            kDeviceId, kCharacteristicId, 0, nullptr,
+            [](const ReadRequestResult *result)
+            { benchmark::sink = benchmark::sink + result->value().size(); },
+            OnError);
+      });
+  benchmark::Compare("speedup", callbackRead, dispatcherRead);
+
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdio>
+
+namespace ble_peripheral
+{
+    namespace test
+    {
+        // Checks that failed so far, main returns non-zero if any did
+        inline int failures = 0;
+
+        inline int Finish(const char *name)
+        {
+            if (failures > 0)
+            {
+                std::fprintf(stderr, "%d checks failed\n", failures);
+                return 1;
+            }
+            std::printf("%s passed\n", name);
+            return 0;
+        }
+
+    } // namespace test
+} // namespace ble_peripheral
+
+#define CHECK(condition)                                                                \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(condition))                                                               \
+        {                                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #condition); \
+            ble_peripheral::test::failures++;                                           \
+        }                                                                               \
+    } while (false)
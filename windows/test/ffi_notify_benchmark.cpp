@@ -0,0 +1,165 @@
+#include "BlePeripheral.g.h"
+#include "benchmark.h"
+#include "hot_message_codec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The native work of one updateCharacteristic up to the buffer handed to NotifyValueAsync, for the
+// three ways Dart can send it. The engine hop onto the platform thread, which only the channel paths
+// take, is not measured. Dart encodes channel messages with the same standard codec layout, so the
+// C++ codec stands in for that side.
+namespace
+{
+  using namespace ble_peripheral;
+  using flutter::EncodableList;
+  using flutter::EncodableValue;
+
+  const std::string kDeviceId = "BluetoothLE#BluetoothLEd0:c6:37:5a:21:0f-4c:11:ae:90:3b:e2";
+  const std::string kCharacteristicId = "6e400003-b5a3-f393-e0a9-e50e24dcca9e";
+
+  int failures = 0;
+
+  // Stands in for the WinRT Buffer NotifyValue fills, allocated per notification like it
+  struct NotifyBuffer
+  {
+    std::unique_ptr<uint8_t[]> data;
+    size_t length = 0;
+  };
+
+  NotifyBuffer CopyToBuffer(const uint8_t *value, size_t length)
+  {
+    NotifyBuffer buffer{std::make_unique<uint8_t[]>(length), length};
+    if (length > 0)
+      std::memcpy(buffer.data.get(), value, length);
+    return buffer;
+  }
+
+  // The value update lib/src/pigeon/hot_message_codec.dart sends
+  std::vector<uint8_t> ValueUpdate(const std::string &characteristicId, const std::vector<uint8_t> &value, const std::string &deviceId)
+  {
+    std::vector<uint8_t> message(hot_message::kRequestHeaderSize + deviceId.size() + characteristicId.size() + value.size());
+    uint16_t deviceIdLength = static_cast<uint16_t>(deviceId.size());
+    uint16_t characteristicIdLength = static_cast<uint16_t>(characteristicId.size());
+    uint32_t valueLength = static_cast<uint32_t>(value.size());
+    std::memcpy(message.data(), &deviceIdLength, sizeof(deviceIdLength));
+    std::memcpy(message.data() + 2, &characteristicIdLength, sizeof(characteristicIdLength));
+    std::memcpy(message.data() + 4, &valueLength, sizeof(valueLength));
+    uint8_t *cursor = message.data() + hot_message::kRequestHeaderSize;
+    std::memcpy(cursor, deviceId.data(), deviceId.size());
+    cursor += deviceId.size();
+    std::memcpy(cursor, characteristicId.data(), characteristicId.size());
+    cursor += characteristicId.size();
+    std::memcpy(cursor, value.data(), value.size());
+    return message;
+  }
+
+  // updateCharacteristic through Pigeon: Dart encodes the arguments, the generated handler decodes
+  // them, NotifyValue copies the value and the handler encodes the empty reply Dart decodes
+  NotifyBuffer ThroughPigeon(const flutter::StandardMessageCodec &codec, const std::vector<uint8_t> &value)
+  {
+    auto message = codec.EncodeMessage(EncodableValue(EncodableList{
+        EncodableValue(kCharacteristicId),
+        EncodableValue(value),
+        EncodableValue(kDeviceId),
+    }));
+
+    auto decoded = codec.DecodeMessage(message->data(), message->size());
+    const auto &args = std::get<EncodableList>(*decoded);
+    const auto &characteristicId = std::get<std::string>(args.at(0));
+    const auto &valueArg = std::get<std::vector<uint8_t>>(args.at(1));
+    const auto *deviceId = std::get_if<std::string>(&args.at(2));
+    benchmark::sink = benchmark::sink + characteristicId.size() + (deviceId == nullptr ? 0 : deviceId->size());
+    NotifyBuffer buffer = CopyToBuffer(valueArg.data(), valueArg.size());
+
+    auto reply = codec.EncodeMessage(EncodableValue(EncodableList{EncodableValue()}));
+    auto decodedReply = codec.DecodeMessage(reply->data(), reply->size());
+    benchmark::sink = benchmark::sink + std::get<EncodableList>(*decodedReply).size();
+    return buffer;
+  }
+
+  // updateCharacteristic on the raw channel of hot_message_codec.h
+  NotifyBuffer ThroughHotMessage(const std::vector<uint8_t> &value)
+  {
+    std::vector<uint8_t> message = ValueUpdate(kCharacteristicId, value, kDeviceId);
+
+    hot_message::ValueUpdateView update;
+    hot_message::DecodeValueUpdate(message.data(), message.size(), update);
+    benchmark::sink = benchmark::sink + update.characteristicId.size() + update.deviceId->size();
+    NotifyBuffer buffer = CopyToBuffer(update.value, update.valueLength);
+
+    std::vector<uint8_t> reply = hot_message::EncodeValueUpdateReply(nullptr);
+    benchmark::sink = benchmark::sink + reply[0];
+    return buffer;
+  }
+
+  // BlePeripheralNotifyValue: Dart passes pointers into its own memory, nothing is encoded
+  NotifyBuffer ThroughFfi(const char *characteristicIdData, size_t characteristicIdLength,
+                          const char *deviceIdData, size_t deviceIdLength,
+                          const uint8_t *value, size_t valueLength)
+  {
+    std::string characteristicId(characteristicIdData, characteristicIdLength);
+    std::string deviceId;
+    if (deviceIdData != nullptr)
+      deviceId.assign(deviceIdData, deviceIdLength);
+    benchmark::sink = benchmark::sink + characteristicId.size() + deviceId.size();
+    return CopyToBuffer(value, valueLength);
+  }
+
+  bool Holds(const NotifyBuffer &buffer, const std::vector<uint8_t> &value)
+  {
+    return buffer.length == value.size() && std::memcmp(buffer.data.get(), value.data(), value.size()) == 0;
+  }
+
+  void Run(size_t valueSize, int iterations)
+  {
+    const flutter::StandardMessageCodec &codec = BlePeripheralChannel::GetCodec();
+    std::vector<uint8_t> value(valueSize);
+    for (size_t i = 0; i < valueSize; ++i)
+      value[i] = static_cast<uint8_t>(i * 17);
+
+    if (!Holds(ThroughPigeon(codec, value), value) || !Holds(ThroughHotMessage(value), value) ||
+        !Holds(ThroughFfi(kCharacteristicId.data(), kCharacteristicId.size(), kDeviceId.data(), kDeviceId.size(), value.data(), valueSize), value))
+    {
+      std::fprintf(stderr, "Notified value differs for %zu byte values\n", valueSize);
+      failures++;
+    }
+
+    std::printf("%zu byte value\n", valueSize);
+    double pigeon = benchmark::Measure(
+        "Pigeon, StandardMessageCodec round trip", iterations,
+        [&]
+        {
+          benchmark::sink = benchmark::sink + ThroughPigeon(codec, value).length;
+        });
+    double hotMessage = benchmark::Measure(
+        "raw channel, fixed layout", iterations,
+        [&]
+        {
+          benchmark::sink = benchmark::sink + ThroughHotMessage(value).length;
+        });
+    double ffi = benchmark::Measure(
+        "dart:ffi, BlePeripheralNotifyValue", iterations,
+        [&]
+        {
+          NotifyBuffer buffer = ThroughFfi(kCharacteristicId.data(), kCharacteristicId.size(),
+                                           kDeviceId.data(), kDeviceId.size(), value.data(), valueSize);
+          benchmark::sink = benchmark::sink + buffer.length;
+        });
+
+    benchmark::Compare("dart:ffi speedup over Pigeon", pigeon, ffi);
+    benchmark::Compare("dart:ffi speedup over raw channel", hotMessage, ffi);
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  int iterations = benchmark::Iterations(argc, argv, 200000);
+  for (size_t valueSize : {20, 244, 512})
+    Run(valueSize, iterations);
+
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#include "BlePeripheral.g.h"
+#include "benchmark.h"
+#include "hot_message_codec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Read and write requests as the standard codec and the fixed layout of hot_message_codec.h carry them:
+// the request native sends and the ReadRequestResult Dart replies with
+namespace
+{
+  using namespace ble_peripheral;
+  using flutter::CustomEncodableValue;
+  using flutter::EncodableList;
+  using flutter::EncodableValue;
+
+  const std::string kDeviceId = "BluetoothLE#BluetoothLEd0:c6:37:5a:21:0f-4c:11:ae:90:3b:e2";
+  const std::string kCharacteristicId = "6e400003-b5a3-f393-e0a9-e50e24dcca9e";
+
+  int failures = 0;
+
+  void Fail(const char *what, size_t valueSize)
+  {
+    std::fprintf(stderr, "%s differs for %zu byte values\n", what, valueSize);
+    failures++;
+  }
+
+  // The reply Dart encodes in lib/src/pigeon/hot_message_codec.dart
+  std::vector<uint8_t> AttributeResult(const std::vector<uint8_t> &value, int64_t offset)
+  {
+    std::vector<uint8_t> reply(hot_message::kResultHeaderSize + value.size());
+    uint32_t valueLength = static_cast<uint32_t>(value.size());
+    int64_t status = 0;
+    reply[0] = hot_message::kHasValue | hot_message::kHasOffset;
+    std::memcpy(reply.data() + 4, &valueLength, sizeof(valueLength));
+    std::memcpy(reply.data() + 8, &offset, sizeof(offset));
+    std::memcpy(reply.data() + 16, &status, sizeof(status));
+    std::memcpy(reply.data() + hot_message::kResultHeaderSize, value.data(), value.size());
+    return reply;
+  }
+
+  void Run(size_t valueSize, int iterations)
+  {
+    const flutter::StandardMessageCodec &codec = BleCallback::GetCodec();
+    std::vector<uint8_t> value(valueSize);
+    for (size_t i = 0; i < valueSize; ++i)
+      value[i] = static_cast<uint8_t>(i * 31);
+    int64_t offset = 0;
+
+    std::vector<uint8_t> scratch;
+    hot_message::EncodeAttributeRequest(scratch, kDeviceId, kCharacteristicId, offset, &value);
+    auto codecRequest = codec.EncodeMessage(EncodableValue(EncodableList{
+        EncodableValue(kDeviceId),
+        EncodableValue(kCharacteristicId),
+        EncodableValue(offset),
+        EncodableValue(value),
+    }));
+
+    // Both encodings carry the same request
+    auto decodedRequest = codec.DecodeMessage(*codecRequest);
+    const auto &arguments = std::get<EncodableList>(*decodedRequest);
+    if (std::get<std::string>(arguments[0]) != kDeviceId || std::get<std::vector<uint8_t>>(arguments[3]) != value ||
+        scratch.size() != hot_message::kRequestHeaderSize + kDeviceId.size() + kCharacteristicId.size() + valueSize ||
+        std::memcmp(scratch.data() + scratch.size() - valueSize, value.data(), valueSize) != 0)
+      Fail("Request", valueSize);
+
+    std::vector<uint8_t> hotReply = AttributeResult(value, offset);
+    auto codecReply = codec.EncodeMessage(EncodableValue(EncodableList{
+        CustomEncodableValue(ReadRequestResult(value, &offset, nullptr)),
+    }));
+
+    hot_message::AttributeResultView view;
+    if (!hot_message::DecodeAttributeResult(hotReply.data(), hotReply.size(), view) ||
+        view.valueLength != valueSize || std::memcmp(view.value, value.data(), valueSize) != 0)
+      Fail("Reply", valueSize);
+    {
+      auto decodedReply = codec.DecodeMessage(*codecReply);
+      const auto &result = std::any_cast<const ReadRequestResult &>(
+          std::get<CustomEncodableValue>(std::get<EncodableList>(*decodedReply)[0]));
+      if (result.value() != value || result.offset() == nullptr || *result.offset() != offset)
+        Fail("Codec reply", valueSize);
+    }
+
+    std::printf("%zu byte value\n", valueSize);
+
+    // What BleCallback::OnReadRequest does before handing the message to the messenger
+    double codecEncode = benchmark::Measure(
+        "encode request, PigeonInternalCodecSerializer", iterations,
+        [&]
+        {
+          auto message = codec.EncodeMessage(EncodableValue(EncodableList{
+              EncodableValue(kDeviceId),
+              EncodableValue(kCharacteristicId),
+              EncodableValue(offset),
+              EncodableValue(value),
+          }));
+          benchmark::sink = benchmark::sink + message->size();
+        });
+    double hotEncode = benchmark::Measure(
+        "encode request, EncodeAttributeRequest", iterations,
+        [&]
+        {
+          hot_message::EncodeAttributeRequest(scratch, kDeviceId, kCharacteristicId, offset, &value);
+          benchmark::sink = benchmark::sink + scratch.size();
+        });
+
+    // What the reply lambda of BleCallback::OnReadRequest does before on_success
+    double codecDecode = benchmark::Measure(
+        "decode reply, PigeonInternalCodecSerializer", iterations,
+        [&]
+        {
+          auto response = codec.DecodeMessage(codecReply->data(), codecReply->size());
+          const auto &list = std::get<EncodableList>(*response);
+          const auto &result = std::any_cast<const ReadRequestResult &>(std::get<CustomEncodableValue>(list[0]));
+          benchmark::sink = benchmark::sink + result.value().size();
+        });
+    double hotDecode = benchmark::Measure(
+        "decode reply, DecodeAttributeResult", iterations,
+        [&]
+        {
+          hot_message::AttributeResultView result;
+          hot_message::DecodeAttributeResult(hotReply.data(), hotReply.size(), result);
+          benchmark::sink = benchmark::sink + result.valueLength;
+        });
+
+    benchmark::Compare("encode speedup", codecEncode, hotEncode);
+    benchmark::Compare("decode speedup", codecDecode, hotDecode);
+    benchmark::Compare("round trip speedup", codecEncode + codecDecode, hotEncode + hotDecode);
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  int iterations = benchmark::Iterations(argc, argv, 200000);
+  for (size_t valueSize : {20, 244, 512})
+    Run(valueSize, iterations);
+
+  return failures > 0 ? 1 : 0;
+}
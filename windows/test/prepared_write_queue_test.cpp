@@ -0,0 +1,120 @@
+#include "check.h"
+#include "prepared_write_queue.h"
+
+#include <string>
+
+// Fragments are appended strictly one after another, the way an ATT bearer delivers them:
+// the central sends the next Prepare Write Request only once the previous one was answered,
+// so every Append has to settle its fragment right away
+namespace
+{
+  using ble_peripheral::PreparedWriteQueue;
+  using Result = PreparedWriteQueue::Result;
+
+  const std::string kDevice = "device";
+  const std::string kOtherDevice = "other device";
+  const std::string kCharacteristic = "characteristic";
+
+  // ATT_MTU 23, the default, leaves 18 bytes of value per Prepare Write Request
+  constexpr size_t kFragment = 18;
+
+  void LongWriteEndingInShortFragment()
+  {
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 36, 14, kFragment) == Result::Complete);
+    CHECK(queue.OpenWrites() == 0);
+  }
+
+  void LongWriteOfWholeFragments()
+  {
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.OpenWrites() == 1);
+
+    // Nothing waits for an end that never comes, the next write simply starts over
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, 4, kFragment) == Result::Complete);
+    CHECK(queue.OpenWrites() == 0);
+  }
+
+  void OrdinaryWritesOfFragmentSize()
+  {
+    PreparedWriteQueue queue;
+    // Each one could start a long write, none is rejected or held for that
+    for (int i = 0; i < 3; ++i)
+      CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, 3, kFragment) == Result::Complete);
+    CHECK(queue.OpenWrites() == 0);
+  }
+
+  void RejectsFragmentsNotContinuingTheWrite()
+  {
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::InvalidOffset);
+
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 20, kFragment, kFragment) == Result::InvalidOffset);
+    // The broken write is forgotten, even its correct continuation is rejected now
+    CHECK(queue.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::InvalidOffset);
+
+    // A short write ends the value, nothing may continue it
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, 5, kFragment) == Result::Complete);
+    CHECK(queue.Append(kDevice, kCharacteristic, 5, 5, kFragment) == Result::InvalidOffset);
+  }
+
+  void StopsAtMaxValueLength()
+  {
+    // ATT_MTU 247 leaves 242 bytes per fragment, the third one reaches 512 bytes
+    constexpr size_t fragment = 242;
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, fragment, fragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 242, fragment, fragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 484, 30, fragment) == Result::InvalidLength);
+    CHECK(queue.OpenWrites() == 0);
+
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, fragment, fragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 242, fragment, fragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 484, 28, fragment) == Result::Complete);
+
+    // A full sized fragment ending exactly at the limit cannot be continued either
+    PreparedWriteQueue small(PreparedWriteQueue::Limits{36});
+    CHECK(small.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(small.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::Complete);
+  }
+
+  void KeepsSessionsApart()
+  {
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kOtherDevice, kCharacteristic, 0, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.Append(kDevice, kCharacteristic, 18, kFragment, kFragment) == Result::Continues);
+    CHECK(queue.OpenWrites() == 2);
+
+    queue.ClearSession(kDevice);
+    CHECK(queue.Append(kDevice, kCharacteristic, 36, 1, kFragment) == Result::InvalidOffset);
+    CHECK(queue.Append(kOtherDevice, kCharacteristic, 18, 1, kFragment) == Result::Complete);
+    CHECK(queue.OpenWrites() == 0);
+  }
+
+  void UnknownMtuEndsEveryWrite()
+  {
+    PreparedWriteQueue queue;
+    CHECK(queue.Append(kDevice, kCharacteristic, 0, kFragment, 0) == Result::Complete);
+    CHECK(queue.OpenWrites() == 0);
+  }
+} // namespace
+
+int main()
+{
+  LongWriteEndingInShortFragment();
+  LongWriteOfWholeFragments();
+  OrdinaryWritesOfFragmentSize();
+  RejectsFragmentsNotContinuingTheWrite();
+  StopsAtMaxValueLength();
+  KeepsSessionsApart();
+  UnknownMtuEndsEveryWrite();
+
+  return ble_peripheral::test::Finish("prepared_write_queue_test");
+}
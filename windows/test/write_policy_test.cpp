@@ -0,0 +1,53 @@
+#include "check.h"
+#include "write_policy.h"
+
+// Writes as WriteRequestedAsync validates them, prepared write fragments one by one with their own offset
+namespace
+{
+  using ble_peripheral::WritePolicy;
+  using Violation = WritePolicy::Violation;
+
+  void ChecksEveryFragmentOffset()
+  {
+    WritePolicy policy;
+    policy.allowedOffsets = {0, 18};
+    CHECK(policy.Validate(0, 18, false) == Violation::None);
+    CHECK(policy.Validate(18, 18, false) == Violation::None);
+    CHECK(policy.Validate(36, 4) == Violation::InvalidOffset);
+
+    // Without 0 only continuations are allowed, ordinary writes are rejected
+    policy.allowedOffsets = {18};
+    CHECK(policy.Validate(0, 4) == Violation::InvalidOffset);
+    CHECK(policy.Validate(18, 4) == Violation::None);
+
+    policy.allowedOffsets.clear();
+    CHECK(policy.Validate(36, 4) == Violation::None);
+    CHECK(policy.Validate(-1, 4) == Violation::InvalidOffset);
+  }
+
+  void ChecksLengthsUpToTheEndOfTheWrite()
+  {
+    WritePolicy policy;
+    policy.maxLength = 40;
+    CHECK(policy.Validate(0, 18, false) == Violation::None);
+    CHECK(policy.Validate(18, 18, false) == Violation::None);
+    CHECK(policy.Validate(36, 4) == Violation::None);
+    CHECK(policy.Validate(36, 5) == Violation::InvalidLength);
+
+    // A fragment that may still be continued is too early to be too short
+    policy.maxLength.reset();
+    policy.minLength = 30;
+    CHECK(policy.Validate(0, 18, false) == Violation::None);
+    CHECK(policy.Validate(0, 18) == Violation::InvalidLength);
+    CHECK(policy.Validate(18, 11) == Violation::InvalidLength);
+    CHECK(policy.Validate(18, 12) == Violation::None);
+  }
+} // namespace
+
+int main()
+{
+  ChecksEveryFragmentOffset();
+  ChecksLengthsUpToTheEndOfTheWrite();
+
+  return ble_peripheral::test::Finish("write_policy_test");
+}
@@ -0,0 +1,23 @@
+#include "write_policy.h"
+
+#include <algorithm>
+
+namespace ble_peripheral
+{
+
+  WritePolicy::Violation WritePolicy::Validate(int64_t offset, size_t length, bool ends) const
+  {
+    if (offset < 0)
+      return Violation::InvalidOffset;
+    if (!allowedOffsets.empty() &&
+        std::find(allowedOffsets.begin(), allowedOffsets.end(), offset) == allowedOffsets.end())
+      return Violation::InvalidOffset;
+    size_t end = static_cast<size_t>(offset) + length;
+    if (ends && minLength && end < *minLength)
+      return Violation::InvalidLength;
+    if (maxLength && end > *maxLength)
+      return Violation::InvalidLength;
+    return Violation::None;
+  }
+
+} // namespace ble_peripheral
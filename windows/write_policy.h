@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace ble_peripheral
+{
+
+    /// Native validation rules of writes to a characteristic, set using setCharacteristicWritePolicy
+    struct WritePolicy
+    {
+        enum class Violation
+        {
+            None,
+            InvalidLength,
+            InvalidOffset,
+        };
+
+        // Respond to valid writes on the WinRT thread, before Dart sees them
+        bool acknowledgeImmediately = false;
+        // Lengths of the value up to the end of the write, minLength only applies once nothing can follow
+        std::optional<size_t> minLength;
+        std::optional<size_t> maxLength;
+        // Offsets a write may start at, each fragment of a prepared (long) write is checked on its own.
+        // Ordinary writes and writeWithoutResponse start at 0, empty allows any offset
+        std::vector<int64_t> allowedOffsets;
+
+        // ends is false for a full sized prepared write fragment that may still be continued
+        Violation Validate(int64_t offset, size_t length, bool ends = true) const;
+    };
+
+} // namespace ble_peripheral
@@ -0,0 +1,79 @@
+#include "write_request_batcher.h"
+
+#include <utility>
+
+namespace ble_peripheral
+{
+  using winrt::Windows::System::Threading::ThreadPoolTimer;
+
+  WriteRequestBatcher::WriteRequestBatcher(BatchFlushPolicy policy, DeliverFunction deliver)
+      : policy_(policy), deliver_(std::move(deliver)) {}
+
+  WriteRequestBatcher::~WriteRequestBatcher()
+  {
+    CancelTimer();
+  }
+
+  void WriteRequestBatcher::Append(const std::string &deviceId, const std::string &characteristicId,
+                                   int64_t offset, const uint8_t *data, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_)
+      return;
+
+    pending_.deviceIds.push_back(deviceId);
+    pending_.characteristicIds.push_back(characteristicId);
+    pending_.offsets.push_back(offset);
+    pending_.values.insert(pending_.values.end(), data, data + size);
+    pending_.lengths.push_back(static_cast<uint32_t>(size));
+
+    if (policy_.ShouldFlush(pending_.count(), pending_.values.size()))
+      FlushLocked();
+    else
+      ArmTimer();
+  }
+
+  void WriteRequestBatcher::Flush()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+  }
+
+  void WriteRequestBatcher::Close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    FlushLocked();
+  }
+
+  void WriteRequestBatcher::FlushLocked()
+  {
+    CancelTimer();
+    if (pending_.empty())
+      return;
+    deliver_(std::exchange(pending_, WriteRequestRecords{}));
+  }
+
+  void WriteRequestBatcher::ArmTimer()
+  {
+    if (timer_ != nullptr)
+      return;
+    std::weak_ptr<WriteRequestBatcher> weak = weak_from_this();
+    timer_ = ThreadPoolTimer::CreateTimer(
+        [weak](ThreadPoolTimer const &)
+        {
+          if (auto self = weak.lock())
+            self->Flush();
+        },
+        policy_.maxLatency);
+  }
+
+  void WriteRequestBatcher::CancelTimer()
+  {
+    if (timer_ == nullptr)
+      return;
+    timer_.Cancel();
+    timer_ = nullptr;
+  }
+
+} // namespace ble_peripheral
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <winrt/Windows.System.Threading.h>
+
+#include "write_stream.h"
+
+namespace ble_peripheral
+{
+
+    /// writeWithoutResponse requests in arrival order, one record per index,
+    /// values are concatenated and split by lengths
+    struct WriteRequestRecords
+    {
+        std::vector<std::string> deviceIds;
+        std::vector<std::string> characteristicIds;
+        std::vector<int64_t> offsets;
+        std::vector<uint8_t> values;
+        std::vector<uint32_t> lengths;
+
+        size_t count() const { return lengths.size(); }
+        bool empty() const { return lengths.empty(); }
+    };
+
+    /// Collects writeWithoutResponse requests of all characteristics and delivers them to Dart
+    /// in a single message by count, bytes or latency.
+    /// Delivery happens under the lock, so batches are handed over in the order requests arrived
+    class WriteRequestBatcher : public std::enable_shared_from_this<WriteRequestBatcher>
+    {
+    public:
+        // Called with the lock held, must not call back into the batcher
+        using DeliverFunction = std::function<void(WriteRequestRecords &&records)>;
+
+        WriteRequestBatcher(BatchFlushPolicy policy, DeliverFunction deliver);
+        ~WriteRequestBatcher();
+
+        WriteRequestBatcher(const WriteRequestBatcher &) = delete;
+        WriteRequestBatcher &operator=(const WriteRequestBatcher &) = delete;
+
+        void Append(const std::string &deviceId, const std::string &characteristicId,
+                    int64_t offset, const uint8_t *data, size_t size);
+        // Delivers buffered requests right away, e.g. before a write with response is dispatched
+        void Flush();
+        void Close();
+
+    private:
+        void FlushLocked();
+        void ArmTimer();
+        void CancelTimer();
+
+        std::mutex mutex_;
+        BatchFlushPolicy policy_;
+        DeliverFunction deliver_;
+        WriteRequestRecords pending_;
+        winrt::Windows::System::Threading::ThreadPoolTimer timer_{nullptr};
+        bool closed_ = false;
+    };
+
+} // namespace ble_peripheral
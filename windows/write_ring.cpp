@@ -0,0 +1,117 @@
+#include "write_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ble_peripheral
+{
+  namespace
+  {
+    // Dart_CObject_kInt64
+    constexpr int32_t kDartCObjectInt64 = 3;
+
+    size_t Align(size_t size)
+    {
+      return (size + WriteRing::kAlignment - 1) & ~(WriteRing::kAlignment - 1);
+    }
+
+    void WriteHeader(uint8_t *record, uint32_t recordLength, uint16_t deviceIdLength,
+                     uint16_t characteristicIdLength, uint32_t offset, uint32_t valueLength)
+    {
+      std::memcpy(record, &recordLength, 4);
+      std::memcpy(record + 4, &deviceIdLength, 2);
+      std::memcpy(record + 6, &characteristicIdLength, 2);
+      std::memcpy(record + 8, &offset, 4);
+      std::memcpy(record + 12, &valueLength, 4);
+    }
+  } // namespace
+
+  WriteRing::WriteRing(size_t capacity, DartPostCObjectFunction postCObject, int64_t port)
+      : capacity_(Align(std::max(capacity, kHeaderSize))),
+        postCObject_(postCObject),
+        port_(port)
+  {
+    data_ = std::make_unique<uint8_t[]>(capacity_);
+  }
+
+  bool WriteRing::Append(const std::string &deviceId, const std::string &characteristicId,
+                         int64_t offset, const uint8_t *value, size_t length)
+  {
+    size_t recordLength = Align(kHeaderSize + deviceId.size() + characteristicId.size() + length);
+    if (recordLength > capacity_ || deviceId.size() >= kPaddingRecord || characteristicId.size() >= kPaddingRecord ||
+        offset < 0 || offset > UINT32_MAX)
+    {
+      dropped_++;
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(producerMutex_);
+      uint64_t head = head_.load(std::memory_order_relaxed);
+      uint64_t tail = tail_.load(std::memory_order_acquire);
+      size_t index = static_cast<size_t>(head % capacity_);
+      size_t padding = capacity_ - index < recordLength ? capacity_ - index : 0;
+      if (capacity_ - (head - tail) < padding + recordLength)
+      {
+        dropped_++;
+        return false;
+      }
+
+      if (padding > 0)
+      {
+        WriteHeader(data_.get() + index, static_cast<uint32_t>(padding), kPaddingRecord, 0, 0, 0);
+        index = 0;
+      }
+      uint8_t *record = data_.get() + index;
+      WriteHeader(record, static_cast<uint32_t>(recordLength), static_cast<uint16_t>(deviceId.size()),
+                  static_cast<uint16_t>(characteristicId.size()), static_cast<uint32_t>(offset), static_cast<uint32_t>(length));
+      uint8_t *cursor = record + kHeaderSize;
+      std::memcpy(cursor, deviceId.data(), deviceId.size());
+      cursor += deviceId.size();
+      std::memcpy(cursor, characteristicId.data(), characteristicId.size());
+      cursor += characteristicId.size();
+      if (length > 0)
+        std::memcpy(cursor, value, length);
+
+      head_.store(head + padding + recordLength, std::memory_order_release);
+    }
+
+    Wake();
+    return true;
+  }
+
+  size_t WriteRing::Readable() const
+  {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t index = static_cast<size_t>(tail % capacity_);
+    return static_cast<size_t>(std::min<uint64_t>(head - tail, capacity_ - index));
+  }
+
+  const uint8_t *WriteRing::ReadPointer() const
+  {
+    return data_.get() + tail_.load(std::memory_order_relaxed) % capacity_;
+  }
+
+  void WriteRing::Release(size_t length)
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + length, std::memory_order_release);
+  }
+
+  void WriteRing::Rearm()
+  {
+    wakePending_.store(false);
+  }
+
+  void WriteRing::Wake()
+  {
+    // One message per drain, Dart reads everything appended until it rearms
+    if (wakePending_.exchange(true))
+      return;
+    DartCObjectInt64 message{};
+    message.type = kDartCObjectInt64;
+    message.value.as_int64 = 0;
+    postCObject_(port_, &message);
+  }
+
+} // namespace ble_peripheral
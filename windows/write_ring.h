@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ble_peripheral
+{
+
+    // Mirrors the leading members of Dart_CObject in dart_native_api.h, only int64 messages are posted
+    struct DartCObjectInt64
+    {
+        int32_t type;
+        union
+        {
+            int64_t as_int64;
+            void *reserved[5];
+        } value;
+    };
+    // Dart_PostCObject, handed over by Dart as NativeApi.postCObject
+    using DartPostCObjectFunction = bool (*)(int64_t port, DartCObjectInt64 *message);
+
+    /// Byte ring carrying writeWithoutResponse requests to Dart, which reads them in place through dart:ffi.
+    /// WinRT threads append under a producer lock, Dart is the only consumer and never takes a lock.
+    /// Positions only grow, a record never wraps around the end of the buffer: when it does not fit
+    /// before the end a padding record fills the rest and the record starts at the beginning.
+    /// Record layout, little endian and 16 byte aligned, see ble_peripheral_ffi.h
+    ///   uint32 recordLength, uint16 deviceIdLength (kPaddingRecord for padding),
+    ///   uint16 characteristicIdLength, uint32 offset, uint32 valueLength,
+    ///   deviceId, characteristicId, value, padding
+    class WriteRing
+    {
+    public:
+        static constexpr size_t kHeaderSize = 16;
+        static constexpr size_t kAlignment = 16;
+        static constexpr uint16_t kPaddingRecord = 0xFFFF;
+
+        // capacity is rounded up to kAlignment, port receives an int64 whenever records become readable
+        WriteRing(size_t capacity, DartPostCObjectFunction postCObject, int64_t port);
+
+        WriteRing(const WriteRing &) = delete;
+        WriteRing &operator=(const WriteRing &) = delete;
+
+        // Returns false and counts the record as dropped when the consumer is too far behind
+        bool Append(const std::string &deviceId, const std::string &characteristicId,
+                    int64_t offset, const uint8_t *value, size_t length);
+
+        // Consumer side, only called by Dart
+        // Readable bytes from the read position up to the end of the buffer
+        size_t Readable() const;
+        const uint8_t *ReadPointer() const;
+        // Marks length bytes as consumed, they may be overwritten right after
+        void Release(size_t length);
+        // Called before draining, records appended afterwards wake Dart again
+        void Rearm();
+
+        uint64_t dropped() const { return dropped_.load(); }
+
+    private:
+        void Wake();
+
+        std::unique_ptr<uint8_t[]> data_;
+        size_t capacity_;
+        DartPostCObjectFunction postCObject_;
+        int64_t port_;
+
+        std::mutex producerMutex_;
+        std::atomic<uint64_t> head_{0};
+        std::atomic<uint64_t> tail_{0};
+        std::atomic<bool> wakePending_{false};
+        std::atomic<uint64_t> dropped_{0};
+    };
+
+} // namespace ble_peripheral
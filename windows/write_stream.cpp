@@ -0,0 +1,223 @@
+#include "write_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace ble_peripheral
+{
+  using winrt::Windows::System::Threading::ThreadPoolTimer;
+
+  // WriteStreamRing
+
+  WriteStreamRing::WriteStreamRing(size_t capacityBytes) : buffer_(capacityBytes) {}
+
+  bool WriteStreamRing::Push(uint16_t deviceSlot, const uint8_t *data, uint32_t size)
+  {
+    if (buffer_.size() - used_ < kHeaderSize + size)
+      return false;
+
+    uint8_t header[kHeaderSize];
+    std::memcpy(header, &size, sizeof(uint32_t));
+    std::memcpy(header + sizeof(uint32_t), &deviceSlot, sizeof(uint16_t));
+    WriteRaw(header, kHeaderSize);
+    WriteRaw(data, size);
+
+    count_++;
+    payloadBytes_ += size;
+    return true;
+  }
+
+  bool WriteStreamRing::PopRun(size_t maxCount, size_t maxBytes, uint16_t &deviceSlot,
+                               std::vector<uint8_t> &data, std::vector<uint32_t> &lengths)
+  {
+    if (count_ == 0)
+      return false;
+
+    uint32_t size = 0;
+    uint16_t slot = 0;
+    ReadHeader(head_, size, slot);
+    deviceSlot = slot;
+
+    size_t popped = 0;
+    size_t poppedBytes = 0;
+    while (count_ > 0 && popped < maxCount)
+    {
+      ReadHeader(head_, size, slot);
+      // Always take the first packet, even if it alone exceeds maxBytes
+      if (slot != deviceSlot || (popped > 0 && poppedBytes + size > maxBytes))
+        break;
+
+      size_t offset = data.size();
+      data.resize(offset + size);
+      PeekRaw((head_ + kHeaderSize) % buffer_.size(), data.data() + offset, size);
+      lengths.push_back(size);
+
+      head_ = (head_ + kHeaderSize + size) % buffer_.size();
+      used_ -= kHeaderSize + size;
+      count_--;
+      payloadBytes_ -= size;
+      popped++;
+      poppedBytes += size;
+    }
+    return true;
+  }
+
+  void WriteStreamRing::WriteRaw(const uint8_t *src, size_t size)
+  {
+    size_t first = (std::min)(size, buffer_.size() - tail_);
+    std::memcpy(buffer_.data() + tail_, src, first);
+    std::memcpy(buffer_.data(), src + first, size - first);
+    tail_ = (tail_ + size) % buffer_.size();
+    used_ += size;
+  }
+
+  void WriteStreamRing::PeekRaw(size_t position, uint8_t *dst, size_t size) const
+  {
+    size_t first = (std::min)(size, buffer_.size() - position);
+    std::memcpy(dst, buffer_.data() + position, first);
+    std::memcpy(dst + first, buffer_.data(), size - first);
+  }
+
+  void WriteStreamRing::ReadHeader(size_t position, uint32_t &size, uint16_t &deviceSlot) const
+  {
+    uint8_t header[kHeaderSize];
+    PeekRaw(position, header, kHeaderSize);
+    std::memcpy(&size, header, sizeof(uint32_t));
+    std::memcpy(&deviceSlot, header + sizeof(uint32_t), sizeof(uint16_t));
+  }
+
+  // WriteStream
+
+  WriteStream::WriteStream(BatchFlushPolicy policy, size_t capacityBytes, DeliverFunction deliver)
+      : policy_(policy), ring_(capacityBytes), deliver_(std::move(deliver)) {}
+
+  WriteStream::~WriteStream()
+  {
+    CancelTimer();
+  }
+
+  void WriteStream::Append(const std::string &deviceId, const uint8_t *data, size_t size)
+  {
+    bool flushNow = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_)
+        return;
+
+      if (!ring_.Push(DeviceSlot(deviceId), data, static_cast<uint32_t>(size)))
+      {
+        droppedPackets_++;
+        droppedBytes_ += size;
+        totalDroppedPackets_++;
+      }
+
+      if (policy_.ShouldFlush(ring_.count(), ring_.bytes()))
+        flushNow = inFlight_ < kMaxInFlight;
+      else if (!ring_.empty())
+        ArmTimer();
+    }
+
+    if (flushNow)
+      Flush();
+  }
+
+  void WriteStream::Flush()
+  {
+    std::vector<WriteStreamChunk> chunks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CancelTimer();
+      while (inFlight_ < kMaxInFlight && !ring_.empty())
+      {
+        WriteStreamChunk chunk;
+        uint16_t slot = 0;
+        ring_.PopRun(policy_.maxCount, policy_.maxBytes, slot, chunk.data, chunk.lengths);
+        chunk.deviceId = devices_[slot];
+        chunk.droppedPackets = std::exchange(droppedPackets_, 0);
+        chunk.droppedBytes = std::exchange(droppedBytes_, 0);
+        chunks.push_back(std::move(chunk));
+        inFlight_++;
+      }
+    }
+
+    // Deliver outside of the lock, WinRT threads keep appending meanwhile
+    std::weak_ptr<WriteStream> weak = weak_from_this();
+    for (auto &chunk : chunks)
+    {
+      deliver_(std::move(chunk), [weak]()
+               {
+                 if (auto self = weak.lock())
+                   self->OnDelivered(); });
+    }
+  }
+
+  void WriteStream::Close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    Flush();
+  }
+
+  uint64_t WriteStream::totalDroppedPackets() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totalDroppedPackets_;
+  }
+
+  uint16_t WriteStream::DeviceSlot(const std::string &deviceId)
+  {
+    // Slots only have to outlive the records referring to them
+    if (ring_.empty())
+      devices_.clear();
+
+    auto it = std::find(devices_.begin(), devices_.end(), deviceId);
+    if (it != devices_.end())
+      return static_cast<uint16_t>(it - devices_.begin());
+    devices_.push_back(deviceId);
+    return static_cast<uint16_t>(devices_.size() - 1);
+  }
+
+  void WriteStream::ArmTimer()
+  {
+    if (timer_ != nullptr)
+      return;
+    std::weak_ptr<WriteStream> weak = weak_from_this();
+    timer_ = ThreadPoolTimer::CreateTimer(
+        [weak](ThreadPoolTimer const &)
+        {
+          if (auto self = weak.lock())
+            self->Flush();
+        },
+        policy_.maxLatency);
+  }
+
+  void WriteStream::CancelTimer()
+  {
+    if (timer_ == nullptr)
+      return;
+    timer_.Cancel();
+    timer_ = nullptr;
+  }
+
+  void WriteStream::OnDelivered()
+  {
+    bool flushNow = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      inFlight_--;
+      if (ring_.empty())
+        return;
+      if (closed_ || policy_.ShouldFlush(ring_.count(), ring_.bytes()))
+        flushNow = true;
+      else
+        ArmTimer();
+    }
+
+    if (flushNow)
+      Flush();
+  }
+
+} // namespace ble_peripheral
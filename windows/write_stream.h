@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <winrt/Windows.System.Threading.h>
+
+namespace ble_peripheral
+{
+
+    /// Thresholds after which buffered data is handed over to Dart
+    struct BatchFlushPolicy
+    {
+        size_t maxCount = 64;
+        size_t maxBytes = 4096;
+        std::chrono::milliseconds maxLatency{20};
+
+        bool ShouldFlush(size_t count, size_t bytes) const
+        {
+            return count >= maxCount || bytes >= maxBytes;
+        }
+    };
+
+    /// Consecutive packets of one device, drained from a WriteStreamRing
+    struct WriteStreamChunk
+    {
+        std::string deviceId;
+        std::vector<uint8_t> data;
+        std::vector<uint32_t> lengths;
+        uint64_t droppedPackets = 0;
+        uint64_t droppedBytes = 0;
+    };
+
+    /// Fixed size byte ring holding length prefixed packets,
+    /// each record is [uint32 length][uint16 device slot][payload]
+    class WriteStreamRing
+    {
+    public:
+        explicit WriteStreamRing(size_t capacityBytes);
+
+        // Returns false if the packet does not fit, the ring is left untouched in that case
+        bool Push(uint16_t deviceSlot, const uint8_t *data, uint32_t size);
+
+        // Pops packets of the same device slot as the oldest record, bounded by maxCount and maxBytes
+        bool PopRun(size_t maxCount, size_t maxBytes, uint16_t &deviceSlot,
+                    std::vector<uint8_t> &data, std::vector<uint32_t> &lengths);
+
+        size_t count() const { return count_; }
+        size_t bytes() const { return payloadBytes_; }
+        bool empty() const { return count_ == 0; }
+
+    private:
+        static constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+
+        void WriteRaw(const uint8_t *src, size_t size);
+        void PeekRaw(size_t position, uint8_t *dst, size_t size) const;
+        void ReadHeader(size_t position, uint32_t &size, uint16_t &deviceSlot) const;
+
+        std::vector<uint8_t> buffer_;
+        size_t head_ = 0;
+        size_t tail_ = 0;
+        size_t used_ = 0;
+        size_t count_ = 0;
+        size_t payloadBytes_ = 0;
+    };
+
+    /// Streaming ingest of writeWithoutResponse packets for a single characteristic.
+    /// Packets are appended from WinRT threads and delivered in batches by count, bytes or latency,
+    /// at most kMaxInFlight batches wait for Dart at a time, packets arriving on a full ring are dropped and counted
+    class WriteStream : public std::enable_shared_from_this<WriteStream>
+    {
+    public:
+        using DeliverFunction = std::function<void(WriteStreamChunk &&chunk, std::function<void()> &&onDelivered)>;
+
+        WriteStream(BatchFlushPolicy policy, size_t capacityBytes, DeliverFunction deliver);
+        ~WriteStream();
+
+        WriteStream(const WriteStream &) = delete;
+        WriteStream &operator=(const WriteStream &) = delete;
+
+        void Append(const std::string &deviceId, const uint8_t *data, size_t size);
+        void Flush();
+        void Close();
+
+        uint64_t totalDroppedPackets() const;
+
+    private:
+        static constexpr size_t kMaxInFlight = 2;
+
+        uint16_t DeviceSlot(const std::string &deviceId);
+        void ArmTimer();
+        void CancelTimer();
+        void OnDelivered();
+
+        mutable std::mutex mutex_;
+        BatchFlushPolicy policy_;
+        WriteStreamRing ring_;
+        DeliverFunction deliver_;
+        std::vector<std::string> devices_;
+        winrt::Windows::System::Threading::ThreadPoolTimer timer_{nullptr};
+        size_t inFlight_ = 0;
+        uint64_t droppedPackets_ = 0;
+        uint64_t droppedBytes_ = 0;
+        uint64_t totalDroppedPackets_ = 0;
+        bool closed_ = false;
+    };
+
+} // namespace ble_peripheral